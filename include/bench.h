@@ -8,24 +8,86 @@
 #include "prng.h"
 #include "cli.h"
 
+// Most separately allocated arrays a benchmark can use
+#define BENCH_MAX_ARRAYS 3
+
 // Worker thread context
 typedef struct {
 	int thread_id;
 	int thread_count;
+	int cpu; // pinned CPU, -1 if unpinned
 
 	// Buffer region for this thread
 	void  *buffer;
 	size_t buffer_size;
 
+	// This thread's slice of each array of a multi-array benchmark, all
+	// buffer_size bytes at the same offset; array[0] is buffer
+	void *array[BENCH_MAX_ARRAYS];
+
+	// stream_*: count the read-for-ownership of each stored line
+	int write_allocate;
+
+	// seq_rw, rand_rw: lines read and written per period of the mix (0:0 =
+	// 1:1), and whether writes go to other lines than the reads
+	uint32_t rw_read;
+	uint32_t rw_write;
+	int		 rw_other;
+
+	// Start of the whole workload buffer, for kernels whose threads share
+	// lines (atomic_*)
+	void *shared;
+
+	// atomic_*: idle cycles after each atomic op (lower = more contention)
+	uint32_t atomic_delay;
+
+	// *_ring: bytes per message (multiple of 8) and slots per ring (power
+	// of 2, fewer if the buffer is too small)
+	uint32_t msg_size;
+	uint32_t ring_slots;
+
 	// Reuse mode parameters
 	int		 reuse_mode;
 	size_t	 region_bytes;
 	uint64_t reuse_iter;
 
+	// Independent chains for ptr_chase_mlp
+	int chains;
+
+	// Idle cycles between ops (seq_* as loaded-latency generators)
+	uint32_t delay;
+
+	// Independent accumulators per seq_* loop iteration (1, 2, 4, 8)
+	int unroll;
+
+	// Precomputed rand_* indices (power of 2), 0 = generate while running
+	uint64_t index_stream;
+
+	// Bytes each gather/scatter step's indices fall within (64, 4096), 0 =
+	// the whole buffer
+	size_t gather_span;
+
+	// *_pf: prefetch instruction and distance (ops or hops ahead, 0 = the
+	// kernel's default)
+	prefetch_t prefetch;
+	uint32_t   prefetch_dist;
+
+	// stride_*: bytes between accessed words (multiple of 8) and direction
+	size_t stride;
+	int	   backward;
+
+	// Core clock measured right after the kernel returned (GHz, 0 if not
+	// probed), while any AVX frequency license still applies
+	double core_ghz;
+
+	// Per-thread state built by the bench init hook (freed with the workload)
+	void *priv;
+
 	// Stop control
 	atomic_int *stop_flag;
 
-	// Stop condition
+	// Stop condition: the coordinator enforces max_seconds via stop_flag,
+	// max_iters (UINT64_MAX when time-based) is checked by the kernel
 	stop_mode_t stop_mode;
 	double		max_seconds;
 	uint64_t	max_iters;
@@ -33,26 +95,109 @@ typedef struct {
 	// Stats
 	thread_stats_t *stats;
 
+	// --perf group counting around the kernel, NULL when off or stopped
+	perf_group_t *perf;
+
+	// Latency sampling: an op is timed when (ops & lat_mask) == lat_mask, so
+	// UINT64_MAX never samples
+	uint64_t lat_mask;
+
 	// PRNG state
 	prng_state_t prng;
 
 	// Barrier for synchronized start
 	pthread_barrier_t *barrier;
-
-	// Start time reference
-	struct timespec *start_time;
 } worker_ctx_t;
 
+// Stop check for kernel loops, called once per block of ops: a relaxed
+// flag load and a compare, no clock reads
+static inline int bench_should_stop(const worker_ctx_t *ctx, uint64_t ops)
+{
+	return atomic_load_explicit(ctx->stop_flag, memory_order_relaxed) ||
+		   ops >= ctx->max_iters;
+}
+
+// One period of a seq_rw/rand_rw mix as three runs of lines: rmw lines
+// read and written, then rd lines only read, then wr lines only written.
+// R:W on the same lines is min(R, W) read-modify-writes plus the excess
+// of one side; with rw_other the R reads and W writes touch R + W lines.
+typedef struct {
+	uint32_t rmw;
+	uint32_t rd;
+	uint32_t wr;
+} rw_mix_t;
+
+// The mix of ctx; 0 if it is the plain 1:1 read-modify-write
+static inline int bench_rw_mix(const worker_ctx_t *ctx, rw_mix_t *mix)
+{
+	uint32_t r = ctx->rw_read, w = ctx->rw_write;
+
+	if (r + w == 0)
+		r = w = 1;
+	if (ctx->rw_other) {
+		mix->rmw = 0;
+		mix->rd	 = r;
+		mix->wr	 = w;
+	} else {
+		mix->rmw = r < w ? r : w;
+		mix->rd	 = r - mix->rmw;
+		mix->wr	 = w - mix->rmw;
+	}
+	return !(mix->rmw == 1 && mix->rd == 0 && mix->wr == 0);
+}
+
+// End of the measured region, for kernels that do unmeasured work before
+// returning (rand_* index calibration): stops the --perf counters there.
+// The runner calls it after the kernel otherwise.
+static inline void bench_measure_end(worker_ctx_t *ctx)
+{
+	if (ctx->perf) {
+		ctx->stats->perf_valid = perf_stop(ctx->perf, ctx->stats->perf);
+		ctx->perf			   = NULL;
+	}
+}
+
+// Spin for roughly delay cycles to throttle a bandwidth generator
+static inline void bench_throttle(uint32_t delay)
+{
+	for (uint32_t i = 0; i < delay; i++)
+		__asm__ volatile("");
+}
+
+// Software prefetch of the line at p. Callers pass a constant hint from a
+// specialized loop. prefetchw is spelled out because compilers only emit it
+// with -mprfchw; older Intel cores decode it as a NOP.
+static inline __attribute__((always_inline)) void
+bench_prefetch(const void *p, const int hint)
+{
+	switch (hint) {
+	case PREFETCH_T2:
+		__builtin_prefetch(p, 0, 1);
+		break;
+	case PREFETCH_NTA:
+		__builtin_prefetch(p, 0, 0);
+		break;
+	case PREFETCH_W:
+		__asm__ volatile("prefetchw %0" : : "m"(*(const char *)p));
+		break;
+	default:
+		__builtin_prefetch(p, 0, 3);
+	}
+}
+
 // Benchmark function type
 typedef void (*bench_func_t)(worker_ctx_t *ctx);
 
 // Benchmark descriptor
 typedef struct {
 	const char	*name;
-	bench_func_t func;
+	bench_func_t func;		 // ISA-independent kernel, NULL if per-ISA
 	int			 reads;		 // 1 if benchmark reads
 	int			 writes;	 // 1 if benchmark writes
 	int			 reuse_mode; // 1 if benchmark uses reuse pattern
+	bench_func_t init;		 // per-thread setup before timing (may be NULL)
+	bench_func_t isa_funcs[ISA_COUNT]; // per-ISA kernels when func is NULL
+	int			 arrays; // separately allocated arrays (1 = the buffer alone)
 } bench_desc_t;
 
 // Get benchmark by name
@@ -61,18 +206,99 @@ const bench_desc_t *bench_lookup(const char *name);
 // List all benchmarks
 void bench_list_all(void);
 
-// Sequential benchmarks
-void bench_seq_read(worker_ctx_t *ctx);
+// Select the ISA of per-ISA kernels for the whole run (ISA_AUTO = widest
+// the CPU supports); -1 if the CPU lacks the requested one
+int bench_set_isa(isa_t isa);
+
+// ISA selected by bench_set_isa
+isa_t bench_isa(void);
+
+// Kernel a benchmark runs with under the selected ISA
+bench_func_t bench_kernel(const bench_desc_t *bench);
+
+// Setup fill of [offset, offset + size) of base with the mem_fill_pattern
+// pattern, at the selected ISA's vector width
+void bench_fill_pattern(void *base, size_t offset, size_t size, uint64_t seed);
+
+// Kernels built once per ISA from bench_seq.c and bench_rand.c
+#define BENCH_ISA_KERNELS(isa)                      \
+	void bench_##isa##_seq_read(worker_ctx_t *ctx);   \
+	void bench_##isa##_seq_write(worker_ctx_t *ctx);  \
+	void bench_##isa##_seq_rw(worker_ctx_t *ctx);	  \
+	void bench_##isa##_rand_read(worker_ctx_t *ctx);  \
+	void bench_##isa##_rand_write(worker_ctx_t *ctx); \
+	void bench_##isa##_rand_rw(worker_ctx_t *ctx);	  \
+	void bench_##isa##_rand_read_pf(worker_ctx_t *ctx); \
+	void bench_##isa##_rand_rw_pf(worker_ctx_t *ctx);	  \
+	void bench_##isa##_gather8(worker_ctx_t *ctx);	  \
+	void bench_##isa##_gather64(worker_ctx_t *ctx);	  \
+	void bench_##isa##_scatter8(worker_ctx_t *ctx);	  \
+	void bench_##isa##_scatter64(worker_ctx_t *ctx);	  \
+	void bench_##isa##_stream_copy(worker_ctx_t *ctx);  \
+	void bench_##isa##_stream_scale(worker_ctx_t *ctx); \
+	void bench_##isa##_stream_add(worker_ctx_t *ctx);	  \
+	void bench_##isa##_stream_triad(worker_ctx_t *ctx); \
+	void bench_##isa##_fill_store(worker_ctx_t *ctx);	  \
+	void bench_##isa##_fill_nt(worker_ctx_t *ctx);	  \
+	void bench_##isa##_copy_store(worker_ctx_t *ctx);	  \
+	void bench_##isa##_copy_nt(worker_ctx_t *ctx);	  \
+	void bench_##isa##_fill_pattern(void *base, size_t offset, size_t size, \
+									uint64_t seed);
+
+BENCH_ISA_KERNELS(scalar)
+BENCH_ISA_KERNELS(sse2)
+BENCH_ISA_KERNELS(avx2)
+BENCH_ISA_KERNELS(avx512)
+
+// ISA-independent sequential benchmarks
 void bench_seq_read_scalar(worker_ctx_t *ctx);
-void bench_seq_write(worker_ctx_t *ctx);
-void bench_seq_rw(worker_ctx_t *ctx);
+void bench_nop(worker_ctx_t *ctx);
+
+// Strided word access, --stride and --direction (ISA-independent)
+void bench_stride_read(worker_ctx_t *ctx);
+void bench_stride_write(worker_ctx_t *ctx);
+void bench_stride_rw(worker_ctx_t *ctx);
+
+// Sets the stream_* arrays to 1.0, 2.0 and 0.0 (ISA-independent)
+void bench_stream_init(worker_ctx_t *ctx);
 
-// Random benchmarks
-void bench_rand_read(worker_ctx_t *ctx);
-void bench_rand_write(worker_ctx_t *ctx);
-void bench_rand_rw(worker_ctx_t *ctx);
+// Fill and copy through rep stosb/movsb and memset/memcpy (ISA-independent)
+void bench_fill_stosb(worker_ctx_t *ctx);
+void bench_fill_memset(worker_ctx_t *ctx);
+void bench_copy_movsb(worker_ctx_t *ctx);
+void bench_copy_memcpy(worker_ctx_t *ctx);
+
+// Atomic increments of a shared, packed (false sharing) or padded counter
+void bench_atomic_add_shared(worker_ctx_t *ctx);
+void bench_atomic_cas_shared(worker_ctx_t *ctx);
+void bench_atomic_add_packed(worker_ctx_t *ctx);
+void bench_atomic_cas_packed(worker_ctx_t *ctx);
+void bench_atomic_add_padded(worker_ctx_t *ctx);
+void bench_atomic_cas_padded(worker_ctx_t *ctx);
+
+// One line ping-ponged between thread pairs (0,1), (2,3), ...
+void bench_c2c_init(worker_ctx_t *ctx);
+void bench_c2c_pingpong(worker_ctx_t *ctx);
+
+// Messages through rings in the buffer: producer/consumer thread pairs
+// (spsc) or threads 1..N-1 into thread 0 (mpsc)
+void bench_spsc_ring_init(worker_ctx_t *ctx);
+void bench_spsc_ring(worker_ctx_t *ctx);
+void bench_mpsc_ring_init(worker_ctx_t *ctx);
+void bench_mpsc_ring(worker_ctx_t *ctx);
+
+// Builds the --index-stream for rand_* (ISA-independent)
+void bench_rand_init(worker_ctx_t *ctx);
 
 // Pointer chase
+void bench_ptr_chase_init(worker_ctx_t *ctx);
 void bench_ptr_chase(worker_ctx_t *ctx);
+void bench_ptr_chase_mlp_init(worker_ctx_t *ctx);
+void bench_ptr_chase_mlp(worker_ctx_t *ctx);
+void bench_ptr_chase_pf_init(worker_ctx_t *ctx);
+void bench_ptr_chase_pf(worker_ctx_t *ctx);
+
+// One pointer-chase hop per 4 KB page (runs bench_ptr_chase)
+void bench_tlb_chase_init(worker_ctx_t *ctx);
 
 #endif // BENCH_H
@@ -8,7 +8,17 @@ typedef enum
 {
 	MODE_SINGLE,
 	MODE_SEQ,
-	MODE_CONCURRENT
+	MODE_CONCURRENT,
+	MODE_MLP,	  // sweep ptr_chase_mlp over chain counts
+	MODE_LOADED,  // ptr_chase probe under stepped bandwidth load
+	MODE_SIZES,	  // sweep working-set size inside one buffer
+	MODE_SCALING, // sweep thread count over one buffer
+	MODE_WIDTH,	  // seq_* over ISA width x unroll at each cache level
+	MODE_TLB,	  // tlb_chase page counts on 4 KB and huge pages
+	MODE_PREFETCH, // *_pf kernels over hint x distance against the plain one
+	MODE_STORES,   // fill_* and copy_* strategies over buffer sizes
+	MODE_C2C,	   // c2c_pingpong over every pair of CPUs
+	MODE_QUEUE	   // spsc_ring and mpsc_ring over message sizes
 } run_mode_t;
 
 typedef enum
@@ -17,8 +27,82 @@ typedef enum
 	STOP_ITERS
 } stop_mode_t;
 
-#define MAX_BENCHES	   16
-#define MAX_BENCH_NAME 32
+typedef enum
+{
+	PIN_NONE,
+	PIN_COMPACT, // fill SMT siblings of a core, then the next core
+	PIN_SCATTER, // spread cores round-robin across packages
+	PIN_CORE,	 // one thread per physical core, no SMT siblings
+	PIN_LIST	 // explicit --cpus list
+} pin_policy_t;
+
+typedef enum
+{
+	NUMA_LOCAL,		 // first touch by the worker that owns each chunk
+	NUMA_BIND,		 // allocate only on the given nodes
+	NUMA_INTERLEAVE, // round-robin pages across nodes
+	NUMA_PREFERRED,	 // prefer one node, fall back to others
+	NUMA_WEIGHTED	 // interleave using the kernel's per-node weights
+} numa_policy_t;
+
+typedef enum
+{
+	PAGES_4K,		  // base pages, THP disabled for the buffer
+	PAGES_THP,		  // transparent huge pages via madvise
+	PAGES_HUGETLB_2M, // reserved 2 MB hugetlb pages
+	PAGES_HUGETLB_1G, // reserved 1 GB hugetlb pages
+	PAGES_AUTO		  // largest hugetlb that fits, then THP, then 4k
+} page_mode_t;
+
+typedef enum
+{
+	FORMAT_TEXT, // key=value lines
+	FORMAT_JSON, // one JSON object per record and line
+	FORMAT_CSV	 // header row per record type, then value rows
+} output_format_t;
+
+// Kernel instruction set, narrowest first
+typedef enum
+{
+	ISA_AUTO = -1, // widest the CPU and OS support
+	ISA_SCALAR,	   // 64-bit general-purpose registers
+	ISA_SSE2,	   // 128-bit, baseline x86-64
+	ISA_AVX2,	   // 256-bit
+	ISA_AVX512,	   // 512-bit (AVX-512F)
+	ISA_COUNT
+} isa_t;
+
+// Software prefetch instruction of the *_pf kernels
+typedef enum
+{
+	PREFETCH_T0,  // prefetcht0: all cache levels
+	PREFETCH_T2,  // prefetcht2: L2 and outward (L3 on current cores)
+	PREFETCH_NTA, // prefetchnta: close to the core, minimal pollution
+	PREFETCH_W,	  // prefetchw: in exclusive state, ready to be written
+	PREFETCH_COUNT
+} prefetch_t;
+
+#define MAX_BENCHES			16
+#define MAX_BENCH_NAME		32
+#define MAX_CPUS			1024
+#define MAX_NUMA_NODES		64
+#define MAX_CHAINS			32
+#define MAX_DELAYS			32
+#define MAX_THREAD_STEPS	64
+#define MAX_UNROLL			8
+#define MAX_PREFETCH_DISTS	16
+#define MAX_PREFETCH_DIST	1024
+#define MAX_MSG_SIZES		16
+#define MAX_RW_RATIO		64
+#define MAX_MSG_SIZE		4096
+#define MAX_RING_SLOTS		(1 << 20)
+#define MAX_PATH			256
+
+// Buffer placement for one workload
+typedef struct {
+	numa_policy_t policy;
+	uint64_t	  nodes; // node bitmask, 0 = all nodes with memory
+} numa_spec_t;
 
 typedef struct {
 	run_mode_t	mode;
@@ -38,8 +122,66 @@ typedef struct {
 	uint64_t reuse_iter;   // iterations per region
 
 	uint64_t seed;			  // PRNG seed
-	int		 pin;			  // CPU pinning
 	double	 report_interval; // reporting interval in seconds
+
+	pin_policy_t pin;				 // CPU pinning policy
+	int			 cpu_list[MAX_CPUS]; // explicit CPUs for PIN_LIST
+	int			 cpu_count;
+	int			 pin_share; // concurrent workloads may share CPUs
+
+	numa_spec_t numa[MAX_BENCHES]; // per-workload placement, in bench order
+	int			numa_count;
+
+	page_mode_t pages; // buffer page size
+
+	int chains[MAX_CHAINS]; // ptr_chase_mlp chain counts
+	int chain_count;
+
+	uint64_t lat_sample; // time 1 in N ops (power of 2), 0 = off
+
+	int delays[MAX_DELAYS]; // loaded-latency generator delays (cycles)
+	int delay_count;
+
+	size_t sweep_min;	// size-sweep range; 0 = defaults
+	size_t sweep_max;
+	int	   sweep_steps; // sizes per doubling
+
+	int thread_list[MAX_THREAD_STEPS]; // scaling-mode thread counts
+	int thread_list_count;
+
+	output_format_t format;			  // stats record format
+	char			output[MAX_PATH]; // record file, "" = stdout
+
+	isa_t isa; // kernel ISA requested with --isa
+
+	int unroll[MAX_UNROLL]; // seq_* accumulator counts (1, 2, 4, 8)
+	int unroll_count;
+
+	uint64_t index_stream; // precomputed rand_* indices, 0 = generate
+
+	size_t gather_span; // --gather-locality: 64 line, 4096 page, 0 random
+
+	int perf; // per-thread hardware counters around each kernel
+
+	prefetch_t prefetch[PREFETCH_COUNT]; // *_pf hints; first outside the sweep
+	int		   prefetch_count;
+	int prefetch_dist[MAX_PREFETCH_DISTS]; // ops (rand) or hops (chase) ahead
+	int prefetch_dist_count;
+
+	size_t stride;	 // stride_* bytes between words
+	int	   backward; // stride_* --direction backward
+
+	int write_allocate; // stream_* count the RFO read of each stored line
+
+	uint32_t rw_read;  // seq_rw/rand_rw lines read per period, 0:0 = 1:1
+	uint32_t rw_write; // lines written per period
+	int		 rw_other; // writes go to other lines than the reads
+
+	uint32_t atomic_delay; // atomic_* idle cycles after each op
+
+	size_t	 msg_size[MAX_MSG_SIZES]; // *_ring message bytes (multiple of 8)
+	int		 msg_size_count;
+	uint32_t ring_slots; // *_ring slots (power of 2)
 } cli_args_t;
 
 // Parse command-line arguments
@@ -51,4 +193,19 @@ void cli_usage(const char *prog);
 // Initialize defaults
 void cli_init_defaults(cli_args_t *args);
 
+// NUMA placement for the workload at position index of the bench list
+const numa_spec_t *cli_numa_spec(const cli_args_t *args, int index);
+
+// Mode name for printing
+const char *cli_mode_name(run_mode_t mode);
+
+// Policy name for printing
+const char *cli_numa_policy_name(numa_policy_t policy);
+
+// Page mode name for printing
+const char *cli_page_mode_name(page_mode_t mode);
+
+// Prefetch hint name for printing ("t0", "t2", "nta", "w")
+const char *cli_prefetch_name(prefetch_t hint);
+
 #endif // CLI_H
@@ -0,0 +1,56 @@
+#ifndef HIST_H
+#define HIST_H
+
+#include <stdint.h>
+
+// Log-bucket latency histogram (HDR-style): values below 2^HIST_SUB_BITS are
+// exact, above that every power of two is split into 2^(HIST_SUB_BITS-1)
+// buckets, so relative error stays under ~3%.
+#define HIST_SUB_BITS 6
+#define HIST_LINEAR	  (1 << HIST_SUB_BITS)
+#define HIST_HALF	  (1 << (HIST_SUB_BITS - 1))
+#define HIST_MAX_BITS 48
+#define HIST_BUCKETS  (HIST_LINEAR + (HIST_MAX_BITS - HIST_SUB_BITS) * HIST_HALF)
+
+// Cache-line aligned so per-thread histograms in one array never share a line
+typedef struct {
+	uint64_t count;
+	uint64_t max;
+	uint64_t buckets[HIST_BUCKETS];
+} __attribute__((aligned(64))) lat_hist_t;
+
+static inline int hist_bucket(uint64_t v)
+{
+	if (v < HIST_LINEAR)
+		return (int)v;
+
+	int msb	  = 63 - __builtin_clzll(v);
+	int shift = msb - (HIST_SUB_BITS - 1);
+	int idx = HIST_LINEAR + (shift - 1) * HIST_HALF + (int)(v >> shift) -
+			  HIST_HALF;
+	return idx < HIST_BUCKETS ? idx : HIST_BUCKETS - 1;
+}
+
+// Record one sample (owner thread only)
+static inline void hist_record(lat_hist_t *h, uint64_t v)
+{
+	h->buckets[hist_bucket(v)]++;
+	h->count++;
+	if (v > h->max)
+		h->max = v;
+}
+
+// Reset to empty
+void hist_clear(lat_hist_t *h);
+
+// dst += src
+void hist_merge(lat_hist_t *dst, const lat_hist_t *src);
+
+// dst = a - b, for interval deltas of a running histogram (max is the
+// upper edge of the highest non-empty bucket)
+void hist_delta(lat_hist_t *dst, const lat_hist_t *a, const lat_hist_t *b);
+
+// Value at quantile q (0..1), as the midpoint of its bucket
+uint64_t hist_percentile(const lat_hist_t *h, double q);
+
+#endif // HIST_H
@@ -0,0 +1,16 @@
+#ifndef ISA_H
+#define ISA_H
+
+#include "cli.h"
+
+// Widest kernel ISA this CPU and OS support (CPUID and XCR0)
+isa_t isa_detect(void);
+
+// Parse an ISA name ("auto", "avx512", "avx2", "sse2", "scalar");
+// returns 0 or -1 if unknown
+int isa_parse(const char *name, isa_t *out);
+
+// ISA name for printing
+const char *isa_name(isa_t isa);
+
+#endif // ISA_H
@@ -2,6 +2,8 @@
 #define MEMORY_H
 
 #include <stddef.h>
+#include <stdint.h>
+#include "cli.h"
 
 // Allocate aligned memory (64-byte alignment for cache lines)
 void *mem_alloc_aligned(size_t size, size_t alignment);
@@ -9,6 +11,37 @@ void *mem_alloc_aligned(size_t size, size_t alignment);
 // Free aligned memory
 void mem_free_aligned(void *ptr);
 
+// Page backing actually found in /proc/self/smaps
+typedef struct {
+	size_t kernel_page_size; // KernelPageSize of the mapping
+	size_t rss_bytes;		 // resident bytes (including hugetlb)
+	size_t huge_bytes;		 // bytes backed by THP or hugetlb pages
+	size_t huge_page_size;	 // size of those huge pages
+} mem_page_info_t;
+
+// Map anonymous memory for benchmark buffers with the requested page size.
+// PAGES_AUTO tries hugetlb, then THP, then 4k; *actual gets what was used.
+void *mem_alloc_pages(size_t size, page_mode_t mode, page_mode_t *actual);
+
+// Unmap memory from mem_alloc_pages (mode as returned in *actual)
+void mem_free_pages(void *ptr, size_t size, page_mode_t mode);
+
+// Page size a mode maps with
+size_t mem_page_size(page_mode_t mode);
+
+// Read page backing of the mapping containing ptr
+int mem_page_info(void *ptr, size_t size, mem_page_info_t *info);
+
+// Apply a NUMA policy to a mapping; must run before pages are touched
+int mem_set_numa_policy(void *ptr, size_t size, numa_policy_t policy,
+						uint64_t nodes);
+
+// Look up the node backing each page (status[i] < 0 if not resident)
+int mem_query_nodes(void **pages, int *status, size_t count);
+
+// Kernel weight for a node under weighted interleave (0 if unknown)
+int mem_interleave_weight(int node);
+
 // Touch all pages to avoid first-touch noise
 void mem_touch_pages(void *ptr, size_t size);
 
@@ -18,4 +51,9 @@ void mem_zero(void *ptr, size_t size);
 // Fill buffer with pattern
 void mem_fill_pattern(void *ptr, size_t size, uint64_t seed);
 
+// Fill [offset, offset + size) of base with the pattern mem_fill_pattern
+// would write there, so threads can fill disjoint chunks
+void mem_fill_pattern_range(void *base, size_t offset, size_t size,
+							uint64_t seed);
+
 #endif // MEMORY_H
@@ -0,0 +1,50 @@
+#ifndef PERF_H
+#define PERF_H
+
+#include <stdint.h>
+
+// Hardware events counted per worker with --perf, in report order
+typedef enum
+{
+	PERF_CYCLES,	   // core cycles
+	PERF_INSTRUCTIONS, // instructions retired
+	PERF_LLC_MISSES,   // last-level cache misses
+	PERF_L1D_REPL,	   // L1D load misses (lines replaced into L1D)
+	PERF_DTLB_MISSES,  // dTLB load misses
+	PERF_NODE_READS,   // reads served by DRAM (offcore response)
+	PERF_EVENT_COUNT
+} perf_event_t;
+
+// One worker's counters: fds in perf_event_t order (-1 = not open), read
+// back through each group leader in open order. Normally one group; one
+// per event if the events do not fit on the PMU together.
+typedef struct {
+	int leader[PERF_EVENT_COUNT];
+	int nleader;
+	int fd[PERF_EVENT_COUNT];
+	int order[PERF_EVENT_COUNT];
+	int count;
+} perf_group_t;
+
+// Open the calling thread's counters, disabled, user space only. Events the
+// CPU, kernel or hypervisor do not offer are left out (reported once per
+// process). If the group cannot be scheduled as a whole (too few counters
+// free), every event is reopened on its own for the kernel to multiplex.
+// Returns the number opened.
+int perf_open(perf_group_t *g);
+
+// Zero and start the counters
+void perf_start(perf_group_t *g);
+
+// Stop the counters and store counts in perf_event_t order, each group
+// scaled up if the kernel multiplexed it; returns a bitmask of the events
+// counted
+unsigned perf_stop(perf_group_t *g, uint64_t *counts);
+
+// Close the counters' fds
+void perf_close(perf_group_t *g);
+
+// Event name for printing
+const char *perf_event_name(perf_event_t event);
+
+#endif // PERF_H
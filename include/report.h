@@ -0,0 +1,27 @@
+#ifndef REPORT_H
+#define REPORT_H
+
+#include <stdint.h>
+#include "cli.h"
+
+// Open the record stream and write the host and config records. Text format
+// keeps the key=value output (sent to --output if given). json/csv write
+// records to --output, or to stdout with all other output moved to stderr.
+int report_open(const cli_args_t *args);
+
+// Flush and close the record stream
+void report_close(void);
+
+// Record format in use
+output_format_t report_format(void);
+
+// Build one record: begin, add fields, end. A record is written whole under
+// a lock. Only the reporter and main threads emit records, never workers.
+// All calls are no-ops in text format.
+void report_begin(const char *type);
+void report_str(const char *key, const char *val);
+void report_u64(const char *key, uint64_t val);
+void report_f(const char *key, double val, int prec); // NaN = no value
+void report_end(void);
+
+#endif // REPORT_H
@@ -4,6 +4,7 @@
 #include "cli.h"
 #include "bench.h"
 #include "stats.h"
+#include "topology.h"
 
 // Workload context
 typedef struct {
@@ -12,12 +13,29 @@ typedef struct {
 	stats_ctx_t			stats;
 
 	void		 *buffer;
+	size_t		  buffer_size; // bytes of each array
+	void		 *arrays[BENCH_MAX_ARRAYS]; // bench->arrays mappings, [0] = buffer
+	int			  narrays;
+	page_mode_t	  pages; // page backing actually mapped
+	size_t		  chunk_size; // per-thread slice of buffer
 	pthread_t	 *threads;
 	worker_ctx_t *worker_ctxs;
+	int			  active; // threads run by workload_start (first N)
+	int			 *cpus; // per-thread CPU, -1 if unpinned
+
+	const topo_t *topo;
+	numa_spec_t	  numa; // buffer placement (nodes resolved)
+
+	int prepared;	// setup phase done; reruns skip it
+	int inited;		// bench init hook ran for the current region sizes
+	int setup_only; // workers return after the setup phase
+	int probe_clock; // workers measure core_ghz after the kernel
 
 	pthread_barrier_t barrier;
-	atomic_int		  stop_flag;
-	struct timespec	  start_time;
+	atomic_int		  stop_flag;	   // raised by the coordinator at the deadline
+	atomic_int		  running_workers; // workers still in the bench function
+	struct timespec	  setup_start; // workers start buffer/bench init
+	struct timespec	  start_time;  // measurement starts
 } workload_ctx_t;
 
 // Run single workload
@@ -29,17 +47,56 @@ int run_sequential(cli_args_t *args);
 // Run concurrent workload list
 int run_concurrent(cli_args_t *args);
 
-// Initialize workload context
+// Initialize workload context. CPUs are placed per args->pin; cpu_used
+// tracks CPUs taken by other workloads (NULL to allow sharing). The buffer,
+// and each further array a multi-array bench uses (args->buffer_size bytes
+// apiece), gets the numa policy and is touched by its owning threads when
+// started.
 int workload_init(workload_ctx_t *wctx, const bench_desc_t *bench,
-				  cli_args_t *args);
+				  cli_args_t *args, const topo_t *topo,
+				  unsigned char *cpu_used, const numa_spec_t *numa);
 
-// Start workload threads
+// Run the workload to completion. The first call also runs the setup phase
+// on the workers; later calls reuse the buffer and reset the stats.
 int workload_start(workload_ctx_t *wctx);
 
+// Run only the setup phase, so workloads started together later all
+// begin measuring at once instead of after their own setup
+int workload_prepare(workload_ctx_t *wctx);
+
+// Shrink every worker's region to a prefix of its own chunk so the workload
+// covers size bytes in total (at most the allocated buffer). The bench init
+// hook reruns on the next start; the buffer is not filled again.
+int workload_resize(workload_ctx_t *wctx, size_t size);
+
+// Run only the first active threads, splitting the whole buffer between
+// them; CPUs keep their placement order. Needs a prepared workload (the fill
+// is done by all threads), and the bench init hook reruns on the next start.
+int workload_set_threads(workload_ctx_t *wctx, int active);
+
+// A workload running on its own thread next to others (concurrent mode)
+typedef struct {
+	workload_ctx_t	  *wctx;
+	pthread_barrier_t *global_barrier; // released once all are launched
+	pthread_t		   thread;
+} concurrent_workload_t;
+
+// Start workload_start on cw->thread behind cw->global_barrier
+int workload_launch(concurrent_workload_t *cw);
+
+// Stop a launched workload early and wait for its thread
+void workload_halt(concurrent_workload_t *cw);
+
 // Wait for workload completion
 void workload_wait(workload_ctx_t *wctx);
 
 // Cleanup workload
 void workload_destroy(workload_ctx_t *wctx);
 
+// Print the CPU assigned to each thread of a workload
+void workload_print_placement(workload_ctx_t *wctx);
+
+// Discover topology; only fatal when pinning was requested
+int runner_topo_init(cli_args_t *args, topo_t *topo);
+
 #endif // RUNNER_H
@@ -5,17 +5,25 @@
 #include <stdatomic.h>
 #include <pthread.h>
 #include <time.h>
+#include "hist.h"
+#include "perf.h"
 
 #define MAX_THREADS		256
 #define CACHE_LINE_SIZE 64
 
-// Per-thread stats (cache-line padded to avoid false sharing)
+// Per-thread stats (cache-line padded to avoid false sharing; the perf
+// counts on the second line are written once, after the kernel)
 typedef struct {
-	uint64_t ops;
-	uint64_t bytes_rd;
-	uint64_t bytes_wr;
-	uint64_t checksum;
-	char	 padding[CACHE_LINE_SIZE - 32];
+	uint64_t	ops;
+	uint64_t	bytes_rd;
+	uint64_t	bytes_wr;
+	uint64_t	checksum;
+	lat_hist_t *hist;		// sampled per-op latency in TSC cycles
+	uint64_t	idx_cycles; // TSC cycles to produce idx_ops random indices
+	uint64_t	idx_ops;	// alone, measured after the run (rand_*)
+	uint64_t	lines;		// lines touched when bytes are not whole lines
+	uint64_t	perf[PERF_EVENT_COUNT]; // --perf counts over the kernel
+	unsigned	perf_valid;				// bitmask of perf_event_t counted
 } __attribute__((aligned(CACHE_LINE_SIZE))) thread_stats_t;
 
 // Workload stats context
@@ -25,6 +33,12 @@ typedef struct {
 
 	// Per-thread local counters
 	thread_stats_t *thread_stats;
+	lat_hist_t	   *thread_hists;
+
+	// Latency: merged totals, snapshot at last interval, interval scratch
+	lat_hist_t *lat_total;
+	lat_hist_t *lat_last;
+	lat_hist_t *lat_interval;
 
 	// Snapshot for interval reporting
 	uint64_t last_ops;
@@ -36,10 +50,16 @@ typedef struct {
 	uint64_t total_bytes_rd;
 	uint64_t total_bytes_wr;
 	uint64_t total_checksum;
+	uint64_t total_idx_cycles;
+	uint64_t total_idx_ops;
+	uint64_t total_lines;
+	uint64_t total_perf[PERF_EVENT_COUNT];
+	unsigned perf_valid; // events every thread counted
 
 	// Timing (pointer to shared start time, owned by workload_ctx_t)
 	struct timespec *start_time;
 	double			 elapsed_sec;
+	double			 setup_sec; // buffer fill + bench init, not measured
 
 	// Control
 	atomic_int running;
@@ -52,9 +72,16 @@ int stats_init(stats_ctx_t *ctx, const char *bench_name, int thread_count);
 // Cleanup stats context
 void stats_destroy(stats_ctx_t *ctx);
 
+// Clear counters so a workload can be run again
+void stats_reset(stats_ctx_t *ctx);
+
 // Start timing (uses shared start_time pointer)
 void stats_start(stats_ctx_t *ctx, struct timespec *start_time);
 
+// Record duration of the setup phase that ended at start_time
+void stats_set_setup(stats_ctx_t *ctx, const struct timespec *setup_start,
+					 const struct timespec *start_time);
+
 // Stop and compute final stats
 void stats_stop(stats_ctx_t *ctx);
 
@@ -0,0 +1,36 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include "cli.h"
+
+// Sweep ptr_chase_mlp over chain counts on one buffer
+int run_mlp(cli_args_t *args);
+
+// Sweep ptr_chase latency against throttled bandwidth generators
+int run_loaded_latency(cli_args_t *args);
+
+// Sweep working-set size over prefixes of one buffer
+int run_size_sweep(cli_args_t *args);
+
+// Sweep thread count over one shared buffer
+int run_scaling(cli_args_t *args);
+
+// Run seq_* over kernel ISA width x unroll at each cache level
+int run_width(cli_args_t *args);
+
+// Sweep tlb_chase page counts on 4 KB and huge-page buffers
+int run_tlb(cli_args_t *args);
+
+// Sweep *_pf prefetch hints and distances against their plain kernels
+int run_prefetch(cli_args_t *args);
+
+// Sweep fill and copy strategies over sizes, with the NT-store crossover
+int run_stores(cli_args_t *args);
+
+// Ping-pong a line between every pair of CPUs: the NxN latency matrix
+int run_c2c(cli_args_t *args);
+
+// spsc_ring and mpsc_ring throughput and latency over message sizes
+int run_queue(cli_args_t *args);
+
+#endif // SWEEP_H
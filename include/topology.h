@@ -0,0 +1,66 @@
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include "cli.h"
+
+// Logical CPU as described by sysfs
+typedef struct {
+	int cpu;	   // logical CPU id
+	int package;   // physical_package_id (socket)
+	int core;	   // core_id (unique within package)
+	int core_rank; // index of this core among its package's cores
+	int smt;	   // index among SMT siblings (0 = first thread of core)
+	int node;	   // NUMA node (0 if unknown)
+	int llc;	   // last-level cache domain (lowest CPU sharing it)
+} topo_cpu_t;
+
+// Machine topology restricted to CPUs this process may run on
+typedef struct {
+	topo_cpu_t *cpus; // sorted by logical CPU id
+	int			count;
+	int			packages;
+	int			cores; // physical cores
+	int			nodes;
+	uint64_t	mem_nodes; // bitmask of nodes with memory
+} topo_t;
+
+#define MAX_CACHES 8
+
+// Data or unified cache as seen by one CPU
+typedef struct {
+	int	   level;
+	char   type;   // 'D' data, 'U' unified
+	size_t size;   // bytes per instance
+	int	   shared; // CPUs sharing one instance
+} topo_cache_t;
+
+// Discover topology from /sys/devices/system/{cpu,node}
+int topo_discover(topo_t *topo);
+
+// Free topology
+void topo_destroy(topo_t *topo);
+
+// Find a CPU by logical id (NULL if not available to this process)
+const topo_cpu_t *topo_find(const topo_t *topo, int cpu);
+
+// Print a one-line topology summary
+void topo_print(const topo_t *topo);
+
+// Assign CPUs to nthreads workers according to policy. CPUs already marked
+// in used[] (indexed by CPU id, MAX_CPUS entries) are skipped while free
+// CPUs remain; chosen CPUs are marked. used may be NULL to allow sharing.
+// out[i] receives the CPU for worker i, or -1 when policy is PIN_NONE.
+int topo_place(const topo_t *topo, pin_policy_t policy, const int *list,
+			   int list_count, int nthreads, unsigned char *used, int *out);
+
+// Data and unified caches of cpu, in sysfs index order (usually by level);
+// returns the count, 0 if sysfs has none
+int topo_caches(int cpu, topo_cache_t *out, int max);
+
+// Parse a CPU list such as "0-3,8,10-11"; returns count or -1 on error
+int topo_parse_cpulist(const char *str, int *out, int max);
+
+// Policy name for printing
+const char *topo_policy_name(pin_policy_t policy);
+
+#endif // TOPOLOGY_H
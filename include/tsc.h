@@ -0,0 +1,35 @@
+#ifndef TSC_H
+#define TSC_H
+
+#include <stdint.h>
+#include <x86intrin.h>
+
+// Timestamp before a timed operation: earlier instructions must finish
+// before the counter is read
+static inline uint64_t tsc_start(void)
+{
+	_mm_lfence();
+	uint64_t t = __rdtsc();
+	_mm_lfence();
+	return t;
+}
+
+// Timestamp after a timed operation: rdtscp waits for earlier loads, the
+// fence keeps later instructions from starting early
+static inline uint64_t tsc_stop(void)
+{
+	unsigned int aux;
+	uint64_t	 t = __rdtscp(&aux);
+	_mm_lfence();
+	return t;
+}
+
+// TSC frequency in GHz (calibrated against CLOCK_MONOTONIC once)
+double tsc_ghz(void);
+
+// Current core clock in GHz from a short chain of dependent adds (one per
+// cycle) timed with the TSC; takes ~20 us, so it sees the frequency the
+// preceding code left the core at
+double tsc_core_ghz(void);
+
+#endif // TSC_H
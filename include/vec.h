@@ -0,0 +1,211 @@
+#ifndef VEC_H
+#define VEC_H
+
+// Vector abstraction for the per-ISA kernels. bench_seq.c and bench_rand.c
+// are compiled once per ISA with one of KERNEL_AVX512, KERNEL_AVX2 or
+// KERNEL_SSE2 defined (none = KERNEL_SCALAR) and the matching -m flags;
+// KERNEL() gives each copy's functions their ISA name. Only include from
+// those files.
+
+#include <stdint.h>
+
+#define CACHE_LINE_SIZE 64
+
+#if defined(KERNEL_AVX512)
+
+#include <immintrin.h>
+#define KERNEL(name) bench_avx512_##name
+#define VEC_BYTES	 64
+typedef __m512i vec_t;
+
+static inline vec_t vec_zero(void) { return _mm512_setzero_si512(); }
+static inline vec_t vec_set1(uint64_t x) { return _mm512_set1_epi64((long long)x); }
+static inline vec_t vec_load(const void *p) { return _mm512_load_si512(p); }
+static inline void	vec_store(void *p, vec_t v) { _mm512_store_si512(p, v); }
+static inline void	vec_stream(void *p, vec_t v) { _mm512_stream_si512((__m512i *)p, v); }
+static inline vec_t vec_xor(vec_t a, vec_t b) { return _mm512_xor_si512(a, b); }
+static inline vec_t vec_add(vec_t a, vec_t b) { return _mm512_add_epi64(a, b); }
+static inline vec_t vec_sll(vec_t v, int n) { return _mm512_slli_epi64(v, (unsigned)n); }
+static inline vec_t vec_srl(vec_t v, int n) { return _mm512_srli_epi64(v, (unsigned)n); }
+static inline vec_t vec_mul32(vec_t a, vec_t b) { return _mm512_mul_epu32(a, b); }
+static inline vec_t vec_gather(const void *p, vec_t off) { return _mm512_i64gather_epi64(off, p, 1); }
+static inline void	vec_scatter(void *p, vec_t off, vec_t v) { _mm512_i64scatter_epi64(p, off, v, 1); }
+static inline vec_t vec_fset1(double x) { return _mm512_castpd_si512(_mm512_set1_pd(x)); }
+static inline vec_t vec_fadd(vec_t a, vec_t b) { return _mm512_castpd_si512(_mm512_add_pd(_mm512_castsi512_pd(a), _mm512_castsi512_pd(b))); }
+static inline vec_t vec_fmul(vec_t a, vec_t b) { return _mm512_castpd_si512(_mm512_mul_pd(_mm512_castsi512_pd(a), _mm512_castsi512_pd(b))); }
+
+#elif defined(KERNEL_AVX2)
+
+#include <immintrin.h>
+#define KERNEL(name) bench_avx2_##name
+#define VEC_BYTES	 32
+typedef __m256i vec_t;
+
+static inline vec_t vec_zero(void) { return _mm256_setzero_si256(); }
+static inline vec_t vec_set1(uint64_t x) { return _mm256_set1_epi64x((long long)x); }
+static inline vec_t vec_load(const void *p) { return _mm256_load_si256((const __m256i *)p); }
+static inline void	vec_store(void *p, vec_t v) { _mm256_store_si256((__m256i *)p, v); }
+static inline void	vec_stream(void *p, vec_t v) { _mm256_stream_si256((__m256i *)p, v); }
+static inline vec_t vec_xor(vec_t a, vec_t b) { return _mm256_xor_si256(a, b); }
+static inline vec_t vec_add(vec_t a, vec_t b) { return _mm256_add_epi64(a, b); }
+static inline vec_t vec_sll(vec_t v, int n) { return _mm256_slli_epi64(v, n); }
+static inline vec_t vec_srl(vec_t v, int n) { return _mm256_srli_epi64(v, n); }
+static inline vec_t vec_mul32(vec_t a, vec_t b) { return _mm256_mul_epu32(a, b); }
+static inline vec_t vec_gather(const void *p, vec_t off) { return _mm256_i64gather_epi64((const long long *)p, off, 1); }
+static inline vec_t vec_fset1(double x) { return _mm256_castpd_si256(_mm256_set1_pd(x)); }
+static inline vec_t vec_fadd(vec_t a, vec_t b) { return _mm256_castpd_si256(_mm256_add_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b))); }
+static inline vec_t vec_fmul(vec_t a, vec_t b) { return _mm256_castpd_si256(_mm256_mul_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b))); }
+
+// No scatter before AVX-512: one store per lane, as a compiler would emit
+static inline void vec_scatter(void *p, vec_t off, vec_t v)
+{
+	uint64_t o[4], x[4];
+	_mm256_storeu_si256((__m256i *)o, off);
+	_mm256_storeu_si256((__m256i *)x, v);
+	for (int i = 0; i < 4; i++)
+		*(uint64_t *)((char *)p + o[i]) = x[i];
+}
+
+#elif defined(KERNEL_SSE2)
+
+#include <emmintrin.h>
+#define KERNEL(name) bench_sse2_##name
+#define VEC_BYTES	 16
+typedef __m128i vec_t;
+
+static inline vec_t vec_zero(void) { return _mm_setzero_si128(); }
+static inline vec_t vec_set1(uint64_t x) { return _mm_set1_epi64x((long long)x); }
+static inline vec_t vec_load(const void *p) { return _mm_load_si128((const __m128i *)p); }
+static inline void	vec_store(void *p, vec_t v) { _mm_store_si128((__m128i *)p, v); }
+static inline void	vec_stream(void *p, vec_t v) { _mm_stream_si128((__m128i *)p, v); }
+static inline vec_t vec_xor(vec_t a, vec_t b) { return _mm_xor_si128(a, b); }
+static inline vec_t vec_add(vec_t a, vec_t b) { return _mm_add_epi64(a, b); }
+static inline vec_t vec_sll(vec_t v, int n) { return _mm_slli_epi64(v, n); }
+static inline vec_t vec_srl(vec_t v, int n) { return _mm_srli_epi64(v, n); }
+static inline vec_t vec_mul32(vec_t a, vec_t b) { return _mm_mul_epu32(a, b); }
+static inline vec_t vec_fset1(double x) { return _mm_castpd_si128(_mm_set1_pd(x)); }
+static inline vec_t vec_fadd(vec_t a, vec_t b) { return _mm_castpd_si128(_mm_add_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b))); }
+static inline vec_t vec_fmul(vec_t a, vec_t b) { return _mm_castpd_si128(_mm_mul_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b))); }
+
+// No gather or scatter instructions: one load or store per lane
+static inline vec_t vec_gather(const void *p, vec_t off)
+{
+	uint64_t o0 = (uint64_t)_mm_cvtsi128_si64(off);
+	uint64_t o1 = (uint64_t)_mm_cvtsi128_si64(_mm_unpackhi_epi64(off, off));
+	return _mm_set_epi64x(*(const long long *)((const char *)p + o1),
+						  *(const long long *)((const char *)p + o0));
+}
+
+static inline void vec_scatter(void *p, vec_t off, vec_t v)
+{
+	uint64_t o0 = (uint64_t)_mm_cvtsi128_si64(off);
+	uint64_t o1 = (uint64_t)_mm_cvtsi128_si64(_mm_unpackhi_epi64(off, off));
+	*(long long *)((char *)p + o0) = _mm_cvtsi128_si64(v);
+	*(long long *)((char *)p + o1) = _mm_cvtsi128_si64(_mm_unpackhi_epi64(v, v));
+}
+
+#else
+
+// Built with -fno-tree-vectorize so these stay 8-byte moves
+#include <emmintrin.h> // movnti and sfence, part of x86-64
+#define KERNEL_SCALAR
+#define KERNEL(name) bench_scalar_##name
+#define VEC_BYTES	 8
+typedef uint64_t vec_t;
+
+static inline vec_t vec_zero(void) { return 0; }
+static inline vec_t vec_set1(uint64_t x) { return x; }
+static inline vec_t vec_load(const void *p) { return *(const uint64_t *)p; }
+static inline void	vec_store(void *p, vec_t v) { *(uint64_t *)p = v; }
+static inline void	vec_stream(void *p, vec_t v) { _mm_stream_si64((long long *)p, (long long)v); }
+static inline vec_t vec_xor(vec_t a, vec_t b) { return a ^ b; }
+static inline vec_t vec_add(vec_t a, vec_t b) { return a + b; }
+static inline vec_t vec_sll(vec_t v, int n) { return v << n; }
+static inline vec_t vec_srl(vec_t v, int n) { return v >> n; }
+static inline vec_t vec_mul32(vec_t a, vec_t b) { return (a & 0xffffffffu) * (b & 0xffffffffu); }
+static inline vec_t vec_gather(const void *p, vec_t off) { return *(const uint64_t *)((const char *)p + off); }
+static inline void	vec_scatter(void *p, vec_t off, vec_t v) { *(uint64_t *)((char *)p + off) = v; }
+
+// Doubles travel as their bit patterns
+static inline double vec_to_f(vec_t v)
+{
+	double x;
+	__builtin_memcpy(&x, &v, sizeof(x));
+	return x;
+}
+static inline vec_t vec_from_f(double x)
+{
+	vec_t v;
+	__builtin_memcpy(&v, &x, sizeof(v));
+	return v;
+}
+static inline vec_t vec_fset1(double x) { return vec_from_f(x); }
+static inline vec_t vec_fadd(vec_t a, vec_t b) { return vec_from_f(vec_to_f(a) + vec_to_f(b)); }
+static inline vec_t vec_fmul(vec_t a, vec_t b) { return vec_from_f(vec_to_f(a) * vec_to_f(b)); }
+
+#endif
+
+// vec_sll/vec_srl shift each 64-bit lane; vec_mul32 multiplies the low 32
+// bits of each lane into a 64-bit product; vec_gather/vec_scatter load or
+// store the 64-bit word at p + each lane's byte offset; vec_fset1/vec_fadd/
+// vec_fmul treat the lanes as doubles; vec_stream is a non-temporal store,
+// ordered against later stores only by vec_sfence
+
+// Drain non-temporal stores (the same sfence at every width)
+static inline void vec_sfence(void)
+{
+	_mm_sfence();
+}
+
+// Vectors per cache line; kernels count one op per line at every width
+#define LINE_VECS (CACHE_LINE_SIZE / VEC_BYTES)
+
+// XOR of the 64-bit lanes, to fold a checksum
+static inline uint64_t vec_fold(vec_t v)
+{
+	uint64_t lanes[VEC_BYTES / 8];
+	uint64_t x = 0;
+	__builtin_memcpy(lanes, &v, sizeof(lanes));
+	for (int i = 0; i < VEC_BYTES / 8; i++)
+		x ^= lanes[i];
+	return x;
+}
+
+// Lane 0
+static inline uint64_t vec_first(vec_t v)
+{
+	uint64_t x;
+	__builtin_memcpy(&x, &v, sizeof(x));
+	return x;
+}
+
+// Load a line, folded to one vector so the caller's accumulator sees one
+// dependent XOR per line at every width
+static inline vec_t line_load(const char *p)
+{
+	vec_t v = vec_load(p);
+	for (int i = 1; i < LINE_VECS; i++)
+		v = vec_xor(v, vec_load(p + i * VEC_BYTES));
+	return v;
+}
+
+// Store v to every vector of a line
+static inline void line_store(char *p, vec_t v)
+{
+	for (int i = 0; i < LINE_VECS; i++)
+		vec_store(p + i * VEC_BYTES, v);
+}
+
+// Add to every vector of a line in place; returns the new line folded
+static inline vec_t line_add(char *p, vec_t add)
+{
+	vec_t x = vec_zero();
+	for (int i = 0; i < LINE_VECS; i++) {
+		vec_t v = vec_add(vec_load(p + i * VEC_BYTES), add);
+		vec_store(p + i * VEC_BYTES, v);
+		x = vec_xor(x, v);
+	}
+	return x;
+}
+
+#endif // VEC_H
@@ -0,0 +1,173 @@
+#include "bench.h"
+
+// How often to update stats (must be power of 2 - 1); contended atomics
+// take hundreds of ns, so blocks are short to keep the stop check prompt
+#define STATS_UPDATE_MASK 0x3FF
+
+// Spacing of the padded counters: two lines, since the adjacent-line
+// prefetcher pulls lines in pairs and would share a 64-byte neighbour
+#define ATOMIC_PAD (2 * CACHE_LINE_SIZE)
+
+enum { ATOMIC_ADD, ATOMIC_CAS };
+enum { ATOMIC_SHARED, ATOMIC_PACKED, ATOMIC_PADDED };
+
+// This thread's counter at the start of the workload's buffer: one word
+// for everyone (shared), consecutive words eight to a line (packed, false
+// sharing) or one word per ATOMIC_PAD bytes (padded, no sharing)
+static uint64_t *atomic_target(const worker_ctx_t *ctx, const int where)
+{
+	char *base = (char *)ctx->shared;
+
+	if (where == ATOMIC_PACKED)
+		return (uint64_t *)(base + (size_t)ctx->thread_id * sizeof(uint64_t));
+	if (where == ATOMIC_PADDED)
+		return (uint64_t *)(base + (size_t)ctx->thread_id * ATOMIC_PAD);
+	return (uint64_t *)base;
+}
+
+// Shared loop of the atomic kernels: one read-modify-write of the counter
+// per op, lock xadd (add) or a lock cmpxchg retried until it succeeds
+// (cas), with atomic_delay idle cycles after each to lower the contention
+static inline __attribute__((always_inline)) void
+atomic_kernel(worker_ctx_t *ctx, const int op, const int where)
+{
+	uint64_t *p		   = atomic_target(ctx, where);
+	uint32_t  delay	   = ctx->atomic_delay;
+	uint64_t  ops	   = 0;
+	uint64_t  checksum = 0;
+
+	// The counters lie inside the buffer while each slice has room for one
+	if (ctx->buffer_size < ATOMIC_PAD)
+		p = NULL;
+
+	while (p && !bench_should_stop(ctx, ops)) {
+		for (int step = 0; step <= STATS_UPDATE_MASK; step++) {
+			if (op == ATOMIC_ADD) {
+				checksum += __atomic_fetch_add(p, 1, __ATOMIC_RELAXED);
+			} else {
+				uint64_t old = __atomic_load_n(p, __ATOMIC_RELAXED);
+				while (!__atomic_compare_exchange_n(p, &old, old + 1, 0,
+													__ATOMIC_RELAXED,
+													__ATOMIC_RELAXED))
+					;
+				checksum += old;
+			}
+			if (delay)
+				bench_throttle(delay);
+		}
+		ops += STATS_UPDATE_MASK + 1;
+
+		ctx->stats->ops		 = ops;
+		ctx->stats->bytes_rd = ops * sizeof(uint64_t);
+		ctx->stats->bytes_wr = ops * sizeof(uint64_t);
+	}
+
+	ctx->stats->ops		 = ops;
+	ctx->stats->bytes_rd = ops * sizeof(uint64_t);
+	ctx->stats->bytes_wr = ops * sizeof(uint64_t);
+	ctx->stats->checksum = checksum;
+}
+
+// Atomic add (lock xadd) and compare-and-swap increments of one shared
+// counter, of packed per-thread counters and of padded ones
+void bench_atomic_add_shared(worker_ctx_t *ctx)
+{
+	atomic_kernel(ctx, ATOMIC_ADD, ATOMIC_SHARED);
+}
+
+void bench_atomic_cas_shared(worker_ctx_t *ctx)
+{
+	atomic_kernel(ctx, ATOMIC_CAS, ATOMIC_SHARED);
+}
+
+void bench_atomic_add_packed(worker_ctx_t *ctx)
+{
+	atomic_kernel(ctx, ATOMIC_ADD, ATOMIC_PACKED);
+}
+
+void bench_atomic_cas_packed(worker_ctx_t *ctx)
+{
+	atomic_kernel(ctx, ATOMIC_CAS, ATOMIC_PACKED);
+}
+
+void bench_atomic_add_padded(worker_ctx_t *ctx)
+{
+	atomic_kernel(ctx, ATOMIC_ADD, ATOMIC_PADDED);
+}
+
+void bench_atomic_cas_padded(worker_ctx_t *ctx)
+{
+	atomic_kernel(ctx, ATOMIC_CAS, ATOMIC_PADDED);
+}
+
+// Written by a ping thread that stops, so its partner stops waiting
+#define C2C_DONE UINT64_MAX
+
+// The line threads 2k and 2k + 1 hand back and forth
+static uint64_t *c2c_line(const worker_ctx_t *ctx)
+{
+	return (uint64_t *)((char *)ctx->shared +
+						(size_t)(ctx->thread_id / 2) * ATOMIC_PAD);
+}
+
+// Spin until the line holds want; 0 if the partner or the run stopped
+static inline int c2c_wait(const worker_ctx_t *ctx, const uint64_t *line,
+						   uint64_t want)
+{
+	uint64_t v;
+	while ((v = __atomic_load_n(line, __ATOMIC_ACQUIRE)) != want) {
+		if (v == C2C_DONE ||
+			atomic_load_explicit(ctx->stop_flag, memory_order_relaxed))
+			return 0;
+	}
+	return 1;
+}
+
+// Clear each pair's line before the start barrier (its ping thread does)
+void bench_c2c_init(worker_ctx_t *ctx)
+{
+	if (ctx->thread_id % 2 == 0 && ctx->buffer_size >= ATOMIC_PAD)
+		__atomic_store_n(c2c_line(ctx), 0, __ATOMIC_RELAXED);
+}
+
+// Ping-pong one line between threads 2k (ping) and 2k + 1 (pong): ping
+// writes an odd sequence number and waits for pong to write the next even
+// one. Each thread counts the handoffs it receives as ops, so ns/op per
+// thread is one round trip; a thread without a partner does nothing.
+void bench_c2c_pingpong(worker_ctx_t *ctx)
+{
+	uint64_t *line = c2c_line(ctx);
+	int		  ping = ctx->thread_id % 2 == 0;
+	uint64_t  ops  = 0;
+
+	if (ctx->buffer_size < ATOMIC_PAD ||
+		(ping && ctx->thread_id + 1 >= ctx->thread_count))
+		line = NULL;
+
+	while (line && !bench_should_stop(ctx, ops)) {
+		for (int step = 0; step <= STATS_UPDATE_MASK; step++) {
+			if (ping) {
+				__atomic_store_n(line, 2 * ops + 1, __ATOMIC_RELEASE);
+				if (!c2c_wait(ctx, line, 2 * ops + 2))
+					goto out;
+			} else {
+				if (!c2c_wait(ctx, line, 2 * ops + 1))
+					goto out;
+				__atomic_store_n(line, 2 * ops + 2, __ATOMIC_RELEASE);
+			}
+			ops++;
+		}
+
+		ctx->stats->ops		 = ops;
+		ctx->stats->bytes_rd = ops * sizeof(uint64_t);
+		ctx->stats->bytes_wr = ops * sizeof(uint64_t);
+	}
+
+out:
+	if (line && ping)
+		__atomic_store_n(line, C2C_DONE, __ATOMIC_RELEASE);
+	ctx->stats->ops		 = ops;
+	ctx->stats->bytes_rd = ops * sizeof(uint64_t);
+	ctx->stats->bytes_wr = ops * sizeof(uint64_t);
+	ctx->stats->checksum = ops;
+}
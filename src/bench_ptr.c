@@ -1,30 +1,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
 #include "bench.h"
 #include "prng.h"
+#include "tsc.h"
+#include "isa.h"
 
 // How often to update stats (must be power of 2 - 1)
 #define STATS_UPDATE_MASK 0x3FFF
 
-// Check if we should stop
-static inline int should_stop(worker_ctx_t *ctx, uint64_t ops)
-{
-	if (atomic_load(ctx->stop_flag))
-		return 1;
-
-	if (ctx->stop_mode == STOP_ITERS) {
-		return ops >= ctx->max_iters;
-	} else {
-		struct timespec now;
-		clock_gettime(CLOCK_MONOTONIC, &now);
-		double elapsed = (double)(now.tv_sec - ctx->start_time->tv_sec) +
-						 (double)(now.tv_nsec - ctx->start_time->tv_nsec) / 1e9;
-		return elapsed >= ctx->max_seconds;
-	}
-}
-
 // Pointer chase node (cache-line sized)
 typedef struct chase_node {
 	struct chase_node *next;
@@ -42,9 +26,10 @@ static void shuffle_indices(uint64_t *arr, size_t n, prng_state_t *prng)
 	}
 }
 
-// Create a random single-cycle permutation
+// Create a random single-cycle permutation. If order is non-NULL it
+// receives the visiting order (caller frees).
 static void create_chase_cycle(chase_node_t *nodes, size_t count,
-							   prng_state_t *prng)
+							   prng_state_t *prng, uint64_t **order)
 {
 	// Create array of indices
 	uint64_t *indices = malloc(count * sizeof(uint64_t));
@@ -64,7 +49,39 @@ static void create_chase_cycle(chase_node_t *nodes, size_t count,
 	}
 	nodes[indices[count - 1]].next = &nodes[indices[0]]; // Close the cycle
 
-	free(indices);
+	if (order)
+		*order = indices;
+	else
+		free(indices);
+}
+
+// Build this thread's random cycle; runs during setup, before timing starts
+void bench_ptr_chase_init(worker_ctx_t *ctx)
+{
+	// Use buffer as node array
+	chase_node_t *nodes = (chase_node_t *)ctx->buffer;
+	size_t		  count = ctx->buffer_size / sizeof(chase_node_t);
+
+	if (count < 2)
+		return;
+
+	// Report initialization start (only from thread 0 to avoid spam)
+	if (ctx->thread_id == 0) {
+		fprintf(stderr,
+				"[ptr_chase] Creating random pointer cycle over %zu nodes "
+				"(%.2f GB per thread)...\n",
+				count,
+				(double)(count * sizeof(chase_node_t)) /
+					(1024.0 * 1024.0 * 1024.0));
+	}
+
+	// Every node's next is written by the cycle; the padding keeps the
+	// fill pattern from setup
+	create_chase_cycle(nodes, count, &ctx->prng, NULL);
+
+	if (ctx->thread_id == 0) {
+		fprintf(stderr, "[ptr_chase] Initialization complete.\n");
+	}
 }
 
 // Pointer chasing benchmark
@@ -82,97 +99,399 @@ void bench_ptr_chase(worker_ctx_t *ctx)
 		return;
 	}
 
-	// Report initialization start (only from thread 0 to avoid spam)
-	if (ctx->thread_id == 0) {
-		fprintf(stderr, "[ptr_chase] Initializing %zu nodes (%.2f GB)...\n",
-				count,
-				(double)(count * sizeof(chase_node_t)) /
-					(1024.0 * 1024.0 * 1024.0));
-	}
+	// Chase pointers
+	uint64_t			   ops		= 0;
+	uint64_t			   checksum = 0;
+	volatile chase_node_t *current	= &nodes[0];
+	uint64_t			   lat_mask = ctx->lat_mask;
 
-	// Initialize nodes with progress reporting
-	size_t progress_interval = count / 10; // Report every 10%
-	if (progress_interval == 0)
-		progress_interval = 1;
+	while (!bench_should_stop(ctx, ops)) {
+		// One block of hops between stop checks, cut short by the budget
+		uint64_t end = ops + STATS_UPDATE_MASK + 1;
+		if (end > ctx->max_iters)
+			end = ctx->max_iters;
 
-	for (size_t i = 0; i < count; i++) {
-		nodes[i].next = NULL;
-		for (int j = 0; j < 7; j++) {
-			nodes[i].pad[j] = (uint64_t)i ^ (uint64_t)j;
+		for (; ops < end; ops++) {
+			// Chase the pointer, timing one hop in lat_mask + 1
+			if ((ops & lat_mask) == lat_mask) {
+				uint64_t t0 = tsc_start();
+				current		= current->next;
+				hist_record(ctx->stats->hist, tsc_stop() - t0);
+			} else {
+				current = current->next;
+			}
+			checksum ^= (uint64_t)(uintptr_t)current;
 		}
-		// Progress report from thread 0
-		if (ctx->thread_id == 0 && i > 0 && (i % progress_interval) == 0) {
-			fprintf(stderr, "[ptr_chase] Node init: %zu%%\n",
-					(i * 100) / count);
+
+		ctx->stats->ops		 = ops;
+		ctx->stats->bytes_rd = ops * 8; // 8 = sizeof(void*)
+		ctx->stats->bytes_wr = 0;
+	}
+
+	// Use volatile to prevent optimization
+	__asm__ volatile("" : : "r"(current) : "memory");
+
+	ctx->stats->ops		 = ops;
+	ctx->stats->bytes_rd = ops * sizeof(void *); // Only reading pointer
+	ctx->stats->bytes_wr = 0;
+	ctx->stats->checksum = checksum;
+}
+
+// Hops ahead of ptr_chase_pf's hint when --prefetch-dist is not given: the
+// node after next
+#define CHASE_PF_DEFAULT_DIST 2
+
+// The ptr_chase cycle, plus a hint in each node's first pad word: the node
+// prefetch_dist hops further along, which a real structure would have to
+// store the same way (a skip pointer)
+void bench_ptr_chase_pf_init(worker_ctx_t *ctx)
+{
+	chase_node_t *nodes = (chase_node_t *)ctx->buffer;
+	size_t		  count = ctx->buffer_size / sizeof(chase_node_t);
+	size_t		  dist	= ctx->prefetch_dist ? ctx->prefetch_dist :
+											   CHASE_PF_DEFAULT_DIST;
+
+	if (count < 2)
+		return;
+
+	uint64_t *order = NULL;
+	create_chase_cycle(nodes, count, &ctx->prng, &order);
+	if (!order)
+		return;
+	for (size_t i = 0; i < count; i++)
+		nodes[order[i]].pad[0] =
+			(uint64_t)(uintptr_t)&nodes[order[(i + dist) % count]];
+	free(order);
+}
+
+// One dependent chain as in ptr_chase; each hop first prefetches the hint
+static inline __attribute__((always_inline)) void
+chase_pf(worker_ctx_t *ctx, const int hint)
+{
+	chase_node_t *cur	   = (chase_node_t *)ctx->buffer;
+	uint64_t	  ops	   = 0;
+	uint64_t	  checksum = 0;
+
+	while (!bench_should_stop(ctx, ops)) {
+		for (int step = 0; step <= STATS_UPDATE_MASK; step++) {
+			bench_prefetch((const void *)(uintptr_t)cur->pad[0], hint);
+			cur = cur->next;
+			checksum ^= (uint64_t)(uintptr_t)cur;
 		}
+		ops += STATS_UPDATE_MASK + 1;
+		ctx->stats->ops		 = ops;
+		ctx->stats->bytes_rd = ops * sizeof(void *);
 	}
 
-	if (ctx->thread_id == 0) {
-		fprintf(stderr, "[ptr_chase] Creating random pointer cycle...\n");
+	ctx->stats->ops		 = ops;
+	ctx->stats->bytes_rd = ops * sizeof(void *);
+	ctx->stats->bytes_wr = 0;
+	ctx->stats->checksum = checksum;
+}
+
+// Pointer chase with a prefetch of the precomputed hint on every hop
+void bench_ptr_chase_pf(worker_ctx_t *ctx)
+{
+	if (ctx->buffer_size / sizeof(chase_node_t) < 2) {
+		ctx->stats->ops		 = 0;
+		ctx->stats->bytes_rd = 0;
+		ctx->stats->bytes_wr = 0;
+		ctx->stats->checksum = 0;
+		return;
+	}
+
+	switch (ctx->prefetch) {
+	case PREFETCH_T2:
+		chase_pf(ctx, PREFETCH_T2);
+		break;
+	case PREFETCH_NTA:
+		chase_pf(ctx, PREFETCH_NTA);
+		break;
+	case PREFETCH_W:
+		chase_pf(ctx, PREFETCH_W);
+		break;
+	default:
+		chase_pf(ctx, PREFETCH_T0);
 	}
+}
+
+// Bytes per page of the tlb_chase pattern: one node per 4 KB page whatever
+// backs the buffer, so huge pages change only how many TLB entries cover it
+#define TLB_PAGE 4096
+
+// Node of page p: a line picked by hashing p, so the nodes spread over the
+// cache sets alike whether the pages are scattered 4 KB frames or contiguous
+// inside huge pages (a fixed line would pile into a few sets of the latter);
+// page 0 uses line 0, where bench_ptr_chase starts
+static chase_node_t *tlb_node(char *buf, size_t p)
+{
+	size_t line = (size_t)(((uint64_t)p * 0x9E3779B97F4A7C15ULL) >> 58);
+	return (chase_node_t *)(buf + p * TLB_PAGE + line * sizeof(chase_node_t));
+}
+
+// One node per page of the region, linked in random page order, so every
+// hop of bench_ptr_chase lands on another page and touches one line of it
+void bench_tlb_chase_init(worker_ctx_t *ctx)
+{
+	char  *buf	 = (char *)ctx->buffer;
+	size_t pages = ctx->buffer_size / TLB_PAGE;
+
+	if (ctx->buffer_size < sizeof(chase_node_t))
+		return;
+	tlb_node(buf, 0)->next = tlb_node(buf, 0); // fewer than two pages
+	if (pages < 2)
+		return;
+
+	uint64_t *order = malloc(pages * sizeof(uint64_t));
+	if (!order)
+		return;
+	for (size_t i = 0; i < pages; i++)
+		order[i] = i;
+	shuffle_indices(order, pages, &ctx->prng);
+	for (size_t i = 0; i < pages; i++)
+		tlb_node(buf, order[i])->next = tlb_node(buf, order[(i + 1) % pages]);
+	free(order);
+}
+
+// Chain heads for every chain count, evenly spaced along one cycle so the
+// chains never meet: heads[K][i] starts chain i of K
+typedef struct {
+	chase_node_t *heads[MAX_CHAINS + 1][MAX_CHAINS];
+} mlp_state_t;
+
+// Build the cycle once and precompute heads for all K, so a sweep over K
+// reuses the same setup
+void bench_ptr_chase_mlp_init(worker_ctx_t *ctx)
+{
+	chase_node_t *nodes = (chase_node_t *)ctx->buffer;
+	size_t		  count = ctx->buffer_size / sizeof(chase_node_t);
 
-	// Create random cycle
-	create_chase_cycle(nodes, count, &ctx->prng);
+	// Drop heads from an earlier, larger region
+	free(ctx->priv);
+	ctx->priv = NULL;
+
+	if (count < MAX_CHAINS)
+		return;
 
 	if (ctx->thread_id == 0) {
 		fprintf(stderr,
-				"[ptr_chase] Initialization complete, starting benchmark.\n");
+				"[ptr_chase_mlp] Creating random pointer cycle over %zu nodes "
+				"(%.2f GB per thread)...\n",
+				count,
+				(double)(count * sizeof(chase_node_t)) /
+					(1024.0 * 1024.0 * 1024.0));
+	}
+
+	uint64_t	*order = NULL;
+	mlp_state_t *state = calloc(1, sizeof(mlp_state_t));
+	create_chase_cycle(nodes, count, &ctx->prng, &order);
+	if (!state || !order) {
+		free(state);
+		free(order);
+		return;
 	}
 
-	// Reset start time so initialization doesn't count toward benchmark time
-	clock_gettime(CLOCK_MONOTONIC, ctx->start_time);
+	for (int k = 1; k <= MAX_CHAINS; k++) {
+		for (int i = 0; i < k; i++) {
+			state->heads[k][i] = &nodes[order[(size_t)i * count / (size_t)k]];
+		}
+	}
+	free(order);
 
-	// Chase pointers
-	uint64_t			   ops		= 0;
-	uint64_t			   checksum = 0;
-	volatile chase_node_t *current	= &nodes[0];
+	ctx->priv = state;
+}
 
-	while (!should_stop(ctx, ops)) {
-		// Chase the pointer
-		current = current->next;
-		checksum ^= (uint64_t)(uintptr_t)current;
-		ops++;
-
-		// Update stats and check stop condition periodically
-		if ((ops & STATS_UPDATE_MASK) == 0) {
-			ctx->stats->ops		 = ops;
-			ctx->stats->bytes_rd = ops * 8; // 8 = sizeof(void*)
-			ctx->stats->bytes_wr = 0;
-			if (should_stop(ctx, ops))
-				break;
+// Walk K chains in lockstep. Each call site passes a constant K, so the
+// inner loop unrolls and the cursors stay in registers.
+static inline __attribute__((always_inline)) void
+chase_chains(worker_ctx_t *ctx, chase_node_t *const *heads, const int K)
+{
+	chase_node_t *cur[MAX_CHAINS];
+	uint64_t	  ops	   = 0;
+	uint64_t	  checksum = 0;
+
+	for (int k = 0; k < K; k++)
+		cur[k] = heads[k];
+
+	while (!bench_should_stop(ctx, ops)) {
+		for (int step = 0; step <= STATS_UPDATE_MASK; step++) {
+			for (int k = 0; k < K; k++)
+				cur[k] = cur[k]->next;
 		}
+		ops += (uint64_t)(STATS_UPDATE_MASK + 1) * (uint64_t)K;
+		ctx->stats->ops		 = ops;
+		ctx->stats->bytes_rd = ops * sizeof(void *);
 	}
 
-	// Use volatile to prevent optimization
-	__asm__ volatile("" : : "r"(current) : "memory");
+	for (int k = 0; k < K; k++)
+		checksum ^= (uint64_t)(uintptr_t)cur[k];
 
 	ctx->stats->ops		 = ops;
-	ctx->stats->bytes_rd = ops * sizeof(void *); // Only reading pointer
+	ctx->stats->bytes_rd = ops * sizeof(void *);
 	ctx->stats->bytes_wr = 0;
 	ctx->stats->checksum = checksum;
 }
 
+#define CHASE_CASE(k)                         \
+	case k:                                   \
+		chase_chains(ctx, state->heads[k], k); \
+		break
+
+// Memory-level parallelism: ctx->chains independent dependent chains
+void bench_ptr_chase_mlp(worker_ctx_t *ctx)
+{
+	mlp_state_t *state = (mlp_state_t *)ctx->priv;
+
+	if (!state || ctx->chains < 1 || ctx->chains > MAX_CHAINS) {
+		ctx->stats->ops		 = 0;
+		ctx->stats->bytes_rd = 0;
+		ctx->stats->bytes_wr = 0;
+		ctx->stats->checksum = 0;
+		return;
+	}
+
+	switch (ctx->chains) {
+		CHASE_CASE(1);
+		CHASE_CASE(2);
+		CHASE_CASE(3);
+		CHASE_CASE(4);
+		CHASE_CASE(5);
+		CHASE_CASE(6);
+		CHASE_CASE(7);
+		CHASE_CASE(8);
+		CHASE_CASE(9);
+		CHASE_CASE(10);
+		CHASE_CASE(11);
+		CHASE_CASE(12);
+		CHASE_CASE(13);
+		CHASE_CASE(14);
+		CHASE_CASE(15);
+		CHASE_CASE(16);
+		CHASE_CASE(17);
+		CHASE_CASE(18);
+		CHASE_CASE(19);
+		CHASE_CASE(20);
+		CHASE_CASE(21);
+		CHASE_CASE(22);
+		CHASE_CASE(23);
+		CHASE_CASE(24);
+		CHASE_CASE(25);
+		CHASE_CASE(26);
+		CHASE_CASE(27);
+		CHASE_CASE(28);
+		CHASE_CASE(29);
+		CHASE_CASE(30);
+		CHASE_CASE(31);
+		CHASE_CASE(32);
+	}
+}
+
+// Per-ISA kernels of one benchmark, in isa_t order
+#define ISA_FUNCS(name)                                            \
+	{ bench_scalar_##name, bench_sse2_##name, bench_avx2_##name, \
+	  bench_avx512_##name }
+#define NO_ISA_FUNCS { NULL }
+
 // Benchmark registry
 static const bench_desc_t benchmarks[] = {
 	// Standard benchmarks (no reuse)
-	{ "seq_read",		  bench_seq_read,		  1, 0, 0 },
-	{ "seq_read_scalar",	 bench_seq_read_scalar, 1, 0, 0 },
-	{ "seq_write",		   bench_seq_write,		0, 1, 0 },
-	{ "seq_rw",			bench_seq_rw,		  1, 1, 0 },
-	{ "rand_read",		   bench_rand_read,		1, 0, 0 },
-	{ "rand_write",		bench_rand_write,	  0, 1, 0 },
-	{ "rand_rw",			 bench_rand_rw,			1, 1, 0 },
-	{ "ptr_chase",		   bench_ptr_chase,		1, 0, 0 },
+	{ "seq_read",		  NULL,					1, 0, 0, NULL,					 ISA_FUNCS(seq_read),     1 },
+	{ "seq_read_scalar",  bench_seq_read_scalar, 1, 0, 0, NULL,					NO_ISA_FUNCS,            1 },
+	{ "seq_write",		  NULL,					0, 1, 0, NULL,					 ISA_FUNCS(seq_write),    1 },
+	{ "seq_rw",			  NULL,					1, 1, 0, NULL,					 ISA_FUNCS(seq_rw),       1 },
+	{ "rand_read",		  NULL,					1, 0, 0, bench_rand_init,		 ISA_FUNCS(rand_read),    1 },
+	{ "rand_write",		  NULL,					0, 1, 0, bench_rand_init,		 ISA_FUNCS(rand_write),   1 },
+	{ "rand_rw",		  NULL,					1, 1, 0, bench_rand_init,		 ISA_FUNCS(rand_rw),      1 },
+	{ "rand_read_pf",	  NULL,					1, 0, 0, NULL,					 ISA_FUNCS(rand_read_pf), 1 },
+	{ "rand_rw_pf",		  NULL,					1, 1, 0, NULL,					 ISA_FUNCS(rand_rw_pf),   1 },
+	{ "stride_read",	  bench_stride_read,	1, 0, 0, NULL,					 NO_ISA_FUNCS,            1 },
+	{ "stride_write",	  bench_stride_write,	0, 1, 0, NULL,					 NO_ISA_FUNCS,            1 },
+	{ "stride_rw",		  bench_stride_rw,		1, 1, 0, NULL,					 NO_ISA_FUNCS,            1 },
+	{ "gather8",		  NULL,					1, 0, 0, NULL,					 ISA_FUNCS(gather8),      1 },
+	{ "gather64",		  NULL,					1, 0, 0, NULL,					 ISA_FUNCS(gather64),     1 },
+	{ "scatter8",		  NULL,					0, 1, 0, NULL,					 ISA_FUNCS(scatter8),     1 },
+	{ "scatter64",		  NULL,					0, 1, 0, NULL,					 ISA_FUNCS(scatter64),    1 },
+	// Scalar-loop baselines of the above at any --isa
+	{ "gather8_scalar",	  bench_scalar_gather8,	1, 0, 0, NULL,					 NO_ISA_FUNCS,            1 },
+	{ "gather64_scalar",  bench_scalar_gather64, 1, 0, 0, NULL,					NO_ISA_FUNCS,            1 },
+	{ "scatter8_scalar",  bench_scalar_scatter8, 0, 1, 0, NULL,					NO_ISA_FUNCS,            1 },
+	{ "scatter64_scalar", bench_scalar_scatter64, 0, 1, 0, NULL,				   NO_ISA_FUNCS,            1 },
+	// STREAM kernels over separately allocated arrays
+	{ "stream_copy",	  NULL,					1, 1, 0, bench_stream_init,	 ISA_FUNCS(stream_copy),  2 },
+	{ "stream_scale",	  NULL,					1, 1, 0, bench_stream_init,	 ISA_FUNCS(stream_scale), 2 },
+	{ "stream_add",		  NULL,					1, 1, 0, bench_stream_init,	 ISA_FUNCS(stream_add),   3 },
+	{ "stream_triad",	  NULL,					1, 1, 0, bench_stream_init,	 ISA_FUNCS(stream_triad), 3 },
+	// Fill and copy strategies (copy: array 0 into array 1)
+	{ "fill_store",		  NULL,					0, 1, 0, NULL,					 ISA_FUNCS(fill_store),   1 },
+	{ "fill_nt",		  NULL,					0, 1, 0, NULL,					 ISA_FUNCS(fill_nt),      1 },
+	{ "fill_stosb",		  bench_fill_stosb,		0, 1, 0, NULL,					 NO_ISA_FUNCS,            1 },
+	{ "fill_memset",	  bench_fill_memset,	0, 1, 0, NULL,					 NO_ISA_FUNCS,            1 },
+	{ "copy_store",		  NULL,					1, 1, 0, NULL,					 ISA_FUNCS(copy_store),   2 },
+	{ "copy_nt",		  NULL,					1, 1, 0, NULL,					 ISA_FUNCS(copy_nt),      2 },
+	{ "copy_movsb",		  bench_copy_movsb,		1, 1, 0, NULL,					 NO_ISA_FUNCS,            2 },
+	{ "copy_memcpy",	  bench_copy_memcpy,	1, 1, 0, NULL,					 NO_ISA_FUNCS,            2 },
+	// Atomic increments; all threads share the buffer's first lines
+	{ "atomic_add_shared", bench_atomic_add_shared, 1, 1, 0, NULL,		 NO_ISA_FUNCS,            1 },
+	{ "atomic_cas_shared", bench_atomic_cas_shared, 1, 1, 0, NULL,		 NO_ISA_FUNCS,            1 },
+	{ "atomic_add_packed", bench_atomic_add_packed, 1, 1, 0, NULL,		 NO_ISA_FUNCS,            1 },
+	{ "atomic_cas_packed", bench_atomic_cas_packed, 1, 1, 0, NULL,		 NO_ISA_FUNCS,            1 },
+	{ "atomic_add_padded", bench_atomic_add_padded, 1, 1, 0, NULL,		 NO_ISA_FUNCS,            1 },
+	{ "atomic_cas_padded", bench_atomic_cas_padded, 1, 1, 0, NULL,		 NO_ISA_FUNCS,            1 },
+	{ "c2c_pingpong",	  bench_c2c_pingpong,	1, 1, 0, bench_c2c_init,		 NO_ISA_FUNCS,            1 },
+	// Message rings; threads share the buffer in producer/consumer groups
+	{ "spsc_ring",		  bench_spsc_ring,		1, 1, 0, bench_spsc_ring_init,	 NO_ISA_FUNCS,            1 },
+	{ "mpsc_ring",		  bench_mpsc_ring,		1, 1, 0, bench_mpsc_ring_init,	 NO_ISA_FUNCS,            1 },
+	{ "ptr_chase",		  bench_ptr_chase,		1, 0, 0, bench_ptr_chase_init,	 NO_ISA_FUNCS,            1 },
+	{ "ptr_chase_mlp",	  bench_ptr_chase_mlp,	1, 0, 0, bench_ptr_chase_mlp_init, NO_ISA_FUNCS,            1 },
+	{ "ptr_chase_pf",	  bench_ptr_chase_pf,	1, 0, 0, bench_ptr_chase_pf_init,	NO_ISA_FUNCS,            1 },
+	{ "tlb_chase",		  bench_ptr_chase,		1, 0, 0, bench_tlb_chase_init,	 NO_ISA_FUNCS,            1 },
+	{ "nop",			  bench_nop,			0, 0, 0, NULL,					 NO_ISA_FUNCS,            1 },
 	// Reuse benchmarks (reuse_mode=1)
-	{ "seq_read_reuse",	bench_seq_read,		1, 0, 1 },
-	{ "seq_write_reuse",	 bench_seq_write,		  0, 1, 1 },
-	{ "seq_rw_reuse",	  bench_seq_rw,			1, 1, 1 },
-	{ "rand_read_reuse",	 bench_rand_read,		  1, 0, 1 },
-	{ "rand_write_reuse", bench_rand_write,		0, 1, 1 },
-	{ "rand_rw_reuse",	   bench_rand_rw,		  1, 1, 1 },
-	{ NULL,			   NULL,				  0, 0, 0 }
+	{ "seq_read_reuse",	  NULL,					1, 0, 1, NULL,					 ISA_FUNCS(seq_read),     1 },
+	{ "seq_write_reuse",  NULL,					0, 1, 1, NULL,					 ISA_FUNCS(seq_write),    1 },
+	{ "seq_rw_reuse",	  NULL,					1, 1, 1, NULL,					 ISA_FUNCS(seq_rw),       1 },
+	{ "rand_read_reuse",  NULL,					1, 0, 1, bench_rand_init,		 ISA_FUNCS(rand_read),    1 },
+	{ "rand_write_reuse", NULL,					0, 1, 1, bench_rand_init,		 ISA_FUNCS(rand_write),   1 },
+	{ "rand_rw_reuse",	  NULL,					1, 1, 1, bench_rand_init,		 ISA_FUNCS(rand_rw),      1 },
+	{ NULL,				  NULL,					0, 0, 0, NULL,					 NO_ISA_FUNCS,            0 }
 };
 
+static isa_t selected_isa = ISA_SCALAR;
+
+int bench_set_isa(isa_t isa)
+{
+	isa_t best = isa_detect();
+
+	if (isa == ISA_AUTO)
+		isa = best;
+	if (isa > best) {
+		fprintf(stderr, "ISA %s not supported by this CPU (widest: %s)\n",
+				isa_name(isa), isa_name(best));
+		return -1;
+	}
+	selected_isa = isa;
+	return 0;
+}
+
+isa_t bench_isa(void)
+{
+	return selected_isa;
+}
+
+bench_func_t bench_kernel(const bench_desc_t *bench)
+{
+	return bench->func ? bench->func : bench->isa_funcs[selected_isa];
+}
+
+void bench_fill_pattern(void *base, size_t offset, size_t size, uint64_t seed)
+{
+	static void (*const fill[ISA_COUNT])(void *, size_t, size_t, uint64_t) = {
+		bench_scalar_fill_pattern, bench_sse2_fill_pattern,
+		bench_avx2_fill_pattern, bench_avx512_fill_pattern
+	};
+	fill[selected_isa](base, offset, size, seed);
+}
+
 const bench_desc_t *bench_lookup(const char *name)
 {
 	for (int i = 0; benchmarks[i].name != NULL; i++) {
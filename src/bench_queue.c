@@ -0,0 +1,230 @@
+#include "bench.h"
+#include "tsc.h"
+
+// How often to update stats (must be power of 2 - 1)
+#define STATS_UPDATE_MASK 0x3FF
+
+// Spacing of the ring indices, two lines apart so the adjacent-line
+// prefetcher never pairs the producer's index with the consumer's
+#define RING_PAD (2 * CACHE_LINE_SIZE)
+
+// Ring of power-of-2 slots in the workload buffer. The indices count
+// messages from 0 and sit on lines of their own; slots follow them.
+typedef struct {
+	uint64_t *tail;	  // messages written (claimed, for MPSC)
+	uint64_t *head;	  // messages read (SPSC; MPSC slots carry a sequence)
+	char	 *slots;
+	size_t	  stride; // bytes per slot
+	size_t	  words;  // 8-byte words per message
+	uint64_t  mask;	  // slots - 1, 0 if the region has no room for a ring
+} ring_t;
+
+// Ring of this thread. SPSC: threads 2k (producer) and 2k + 1 (consumer)
+// share one in their two buffer slices. MPSC: thread 0 consumes from one
+// ring over the whole buffer, fed by every other thread. --ring-slots is
+// halved until the ring fits its region.
+static void ring_layout(const worker_ctx_t *ctx, const int mpsc, ring_t *r)
+{
+	char  *base	 = (char *)ctx->shared;
+	size_t bytes = ctx->buffer_size * (size_t)ctx->thread_count;
+
+	if (!mpsc) {
+		base += (size_t)(ctx->thread_id / 2) * 2 * ctx->buffer_size;
+		bytes = 2 * ctx->buffer_size;
+	}
+
+	r->tail	  = (uint64_t *)base;
+	r->head	  = (uint64_t *)(base + RING_PAD);
+	r->slots  = base + 2 * RING_PAD;
+	r->words  = ctx->msg_size / sizeof(uint64_t);
+	r->stride = ctx->msg_size + (mpsc ? sizeof(uint64_t) : 0);
+	r->mask	  = 0;
+
+	if (bytes < 2 * RING_PAD + 2 * r->stride)
+		return;
+	uint64_t slots = ctx->ring_slots;
+	while (slots > 2 && slots * r->stride > bytes - 2 * RING_PAD)
+		slots /= 2;
+	r->mask = slots - 1;
+}
+
+// Write message seq: word 0 carries the send time when the message is
+// sampled for latency, every other word the sequence number
+static inline void ring_put(uint64_t *msg, size_t words, uint64_t seq,
+							uint64_t lat_mask)
+{
+	msg[0] = (seq & lat_mask) == lat_mask ? tsc_start() : seq;
+	for (size_t i = 1; i < words; i++)
+		msg[i] = seq;
+}
+
+// Read message seq, recording its queueing latency if sampled; returns
+// the sum of its words for the checksum (as if word 0 held seq)
+static inline uint64_t ring_get(const worker_ctx_t *ctx, const uint64_t *msg,
+								size_t words, uint64_t seq)
+{
+	uint64_t x = msg[0];
+	for (size_t i = 1; i < words; i++)
+		x += msg[i];
+
+	if ((seq & ctx->lat_mask) == ctx->lat_mask) {
+		uint64_t now = tsc_stop();
+		if (now > msg[0])
+			hist_record(ctx->stats->hist, now - msg[0]);
+		x = x - msg[0] + seq;
+	}
+	return x;
+}
+
+// Stop check for the spin loops on a full or empty ring
+static inline int ring_stopped(const worker_ctx_t *ctx)
+{
+	return atomic_load_explicit(ctx->stop_flag, memory_order_relaxed);
+}
+
+// Zero each pair's indices (its producer does)
+void bench_spsc_ring_init(worker_ctx_t *ctx)
+{
+	ring_t r;
+	ring_layout(ctx, 0, &r);
+	if (ctx->thread_id % 2 == 0 && r.mask) {
+		__atomic_store_n(r.tail, 0, __ATOMIC_RELAXED);
+		__atomic_store_n(r.head, 0, __ATOMIC_RELAXED);
+	}
+}
+
+// Single-producer single-consumer ring (Lamport queue with cached
+// indices): each side publishes its own index with a release store and
+// re-reads the other's only when the ring looks full or empty. Consumers
+// count the messages they receive as ops; producers count only the bytes
+// they write. A producer without a consumer does nothing.
+void bench_spsc_ring(worker_ctx_t *ctx)
+{
+	ring_t r;
+	ring_layout(ctx, 0, &r);
+
+	int		 producer = ctx->thread_id % 2 == 0;
+	uint64_t cap	  = r.mask + 1;
+	uint64_t other	  = 0; // last index seen of the other side
+	uint64_t n		  = 0; // messages sent or received
+	uint64_t checksum = 0;
+	uint64_t msg_size = ctx->msg_size;
+
+	if (producer && ctx->thread_id + 1 >= ctx->thread_count)
+		r.mask = 0;
+
+	while (r.mask && !bench_should_stop(ctx, n)) {
+		uint64_t end = n + STATS_UPDATE_MASK + 1;
+		if (end > ctx->max_iters)
+			end = ctx->max_iters;
+
+		for (; n < end; n++) {
+			uint64_t *msg = (uint64_t *)(r.slots + (n & r.mask) * r.stride);
+			if (producer) {
+				while (n - other == cap) {
+					other = __atomic_load_n(r.head, __ATOMIC_ACQUIRE);
+					if (n - other == cap && ring_stopped(ctx))
+						goto out;
+				}
+				ring_put(msg, r.words, n, ctx->lat_mask);
+				__atomic_store_n(r.tail, n + 1, __ATOMIC_RELEASE);
+			} else {
+				while (other == n) {
+					other = __atomic_load_n(r.tail, __ATOMIC_ACQUIRE);
+					if (other == n && ring_stopped(ctx))
+						goto out;
+				}
+				checksum += ring_get(ctx, msg, r.words, n);
+				__atomic_store_n(r.head, n + 1, __ATOMIC_RELEASE);
+			}
+		}
+
+		ctx->stats->ops		 = producer ? 0 : n;
+		ctx->stats->bytes_rd = producer ? 0 : n * msg_size;
+		ctx->stats->bytes_wr = producer ? n * msg_size : 0;
+	}
+
+out:
+	ctx->stats->ops		 = producer ? 0 : n;
+	ctx->stats->bytes_rd = producer ? 0 : n * msg_size;
+	ctx->stats->bytes_wr = producer ? n * msg_size : 0;
+	ctx->stats->checksum = checksum;
+}
+
+// Zero the claim counter and give slot i sequence i (the consumer does)
+void bench_mpsc_ring_init(worker_ctx_t *ctx)
+{
+	ring_t r;
+	ring_layout(ctx, 1, &r);
+	if (ctx->thread_id != 0 || !r.mask)
+		return;
+
+	__atomic_store_n(r.tail, 0, __ATOMIC_RELAXED);
+	for (uint64_t i = 0; i <= r.mask; i++)
+		__atomic_store_n((uint64_t *)(r.slots + i * r.stride), i,
+						 __ATOMIC_RELAXED);
+}
+
+// Multi-producer single-consumer ring (bounded queue with per-slot
+// sequence numbers): a producer claims message pos with a fetch-add on
+// the tail, waits until the slot's sequence is pos (free), writes the
+// message and publishes pos + 1; the consumer waits for pos + 1, reads
+// and frees the slot for pos + slots. Thread 0 consumes, counting the
+// messages it receives as ops; with --iters every producer sends its
+// share and the consumer stops after all of them.
+void bench_mpsc_ring(worker_ctx_t *ctx)
+{
+	ring_t r;
+	ring_layout(ctx, 1, &r);
+
+	int		 consumer = ctx->thread_id == 0;
+	uint64_t cap	  = r.mask + 1;
+	uint64_t n		  = 0;
+	uint64_t checksum = 0;
+	uint64_t msg_size = ctx->msg_size;
+	uint64_t budget	  = ctx->max_iters;
+
+	if (consumer && budget != UINT64_MAX)
+		budget *= (uint64_t)(ctx->thread_count - 1);
+	if (ctx->thread_count < 2)
+		r.mask = 0;
+
+	while (r.mask && n < budget && !ring_stopped(ctx)) {
+		uint64_t end = n + STATS_UPDATE_MASK + 1;
+		if (end > budget)
+			end = budget;
+
+		for (; n < end; n++) {
+			if (consumer) {
+				uint64_t *seq =
+					(uint64_t *)(r.slots + (n & r.mask) * r.stride);
+				while (__atomic_load_n(seq, __ATOMIC_ACQUIRE) != n + 1) {
+					if (ring_stopped(ctx))
+						goto out;
+				}
+				checksum += ring_get(ctx, seq + 1, r.words, n);
+				__atomic_store_n(seq, n + cap, __ATOMIC_RELEASE);
+			} else {
+				uint64_t  pos = __atomic_fetch_add(r.tail, 1, __ATOMIC_RELAXED);
+				uint64_t *seq =
+					(uint64_t *)(r.slots + (pos & r.mask) * r.stride);
+				while (__atomic_load_n(seq, __ATOMIC_ACQUIRE) != pos) {
+					if (ring_stopped(ctx))
+						goto out;
+				}
+				ring_put(seq + 1, r.words, pos, ctx->lat_mask);
+				__atomic_store_n(seq, pos + 1, __ATOMIC_RELEASE);
+			}
+		}
+
+		ctx->stats->ops		 = consumer ? n : 0;
+		ctx->stats->bytes_rd = consumer ? n * msg_size : 0;
+		ctx->stats->bytes_wr = consumer ? 0 : n * msg_size;
+	}
+
+out:
+	ctx->stats->ops		 = consumer ? n : 0;
+	ctx->stats->bytes_rd = consumer ? n * msg_size : 0;
+	ctx->stats->bytes_wr = consumer ? 0 : n * msg_size;
+	ctx->stats->checksum = checksum;
+}
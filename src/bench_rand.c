@@ -1,223 +1,508 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
-#include <time.h>
-#include <immintrin.h>
 #include "bench.h"
 #include "prng.h"
-
-#define CACHE_LINE_SIZE 64
-#define ZMM_SIZE		64
+#include "tsc.h"
+#include "vec.h"
 
 // How often to update stats (must be power of 2 - 1)
 #define STATS_UPDATE_MASK 0x1ffff
 
-// Check if we should stop
-static inline int should_stop(worker_ctx_t *ctx, uint64_t ops)
+// Indices per generator step: eight xorshift64 lanes, held in one zmm, two
+// ymm, four xmm or eight general-purpose registers
+#define IDX_LANES 8
+#define IDX_VECS  (IDX_LANES * 8 / VEC_BYTES)
+
+// Indices timed after each run to price index generation on its own
+#define IDX_CAL_OPS 65536
+
+// Multi-lane index generator. Each lane is an independent xorshift64; a
+// 32-bit slice of it is scaled to [0, lines) with a multiply and a shift
+// (Lemire's reduction) instead of a modulo, so there is no divide and no
+// serial dependency between the indices of one step.
+typedef struct {
+	vec_t	 s[IDX_VECS];
+	uint64_t off[IDX_LANES] __attribute__((aligned(64))); // byte offsets
+} idx_gen_t;
+
+// Precomputed indices built by bench_rand_init (--index-stream), replayed
+// in order and wrapped; lines is the range they were drawn from
+typedef struct {
+	uint64_t lines;
+	size_t	 len; // power of 2, multiple of IDX_LANES
+	uint32_t idx[];
+} idx_stream_t;
+
+static inline void idx_seed(idx_gen_t *g, prng_state_t *prng)
 {
-	if (atomic_load(ctx->stop_flag))
-		return 1;
+	uint64_t seed[IDX_LANES] __attribute__((aligned(64)));
+	for (int i = 0; i < IDX_LANES; i++)
+		seed[i] = prng_next(prng);
+	for (int v = 0; v < IDX_VECS; v++)
+		g->s[v] = vec_load(&seed[v * (VEC_BYTES / 8)]);
+}
 
-	if (ctx->stop_mode == STOP_ITERS) {
-		return ops >= ctx->max_iters;
-	} else {
-		struct timespec now;
-		clock_gettime(CLOCK_MONOTONIC, &now);
-		double elapsed = (double)(now.tv_sec - ctx->start_time->tv_sec) +
-						 (double)(now.tv_nsec - ctx->start_time->tv_nsec) / 1e9;
-		return elapsed >= ctx->max_seconds;
+// Advance the lanes of vector v and scale each to [0, n); n must fit in 32
+// bits
+static inline vec_t idx_step(idx_gen_t *g, int v, vec_t n)
+{
+	vec_t x = g->s[v];
+	x		= vec_xor(x, vec_sll(x, 13));
+	x		= vec_xor(x, vec_srl(x, 7));
+	x		= vec_xor(x, vec_sll(x, 17));
+	g->s[v] = x;
+	return vec_srl(vec_mul32(vec_srl(x, 32), n), 32);
+}
+
+// Next IDX_LANES byte offsets of lines in [0, lines) into g->off. lines
+// must fit in 32 bits (256 GB of lines), which the callers enforce.
+static inline void idx_next(idx_gen_t *g, vec_t lines)
+{
+	for (int v = 0; v < IDX_VECS; v++)
+		vec_store(&g->off[v * (VEC_BYTES / 8)], vec_sll(idx_step(g, v, lines), 6));
+}
+
+// Next batch from the stream, or from the generator without one
+static inline const uint64_t *idx_batch(idx_gen_t *g, vec_t lines,
+										const idx_stream_t *stream,
+										size_t *pos)
+{
+	if (!stream) {
+		idx_next(g, lines);
+		return g->off;
 	}
+	const uint32_t *p = &stream->idx[*pos];
+	for (int i = 0; i < IDX_LANES; i++)
+		g->off[i] = (uint64_t)p[i] << 6;
+	*pos = (*pos + IDX_LANES) & (stream->len - 1);
+	return g->off;
 }
 
-// Inline stats update
-static inline void update_stats(worker_ctx_t *ctx, uint64_t ops,
-								uint64_t bytes_rd, uint64_t bytes_wr)
+// Lines a kernel draws indices from: a reuse region or the whole buffer,
+// capped at 2^32 - 1 (idx_step scales by the low 32 bits of the count)
+static inline uint64_t rand_lines(const worker_ctx_t *ctx)
 {
-	if ((ops & STATS_UPDATE_MASK) == 0) {
-		ctx->stats->ops		 = ops;
-		ctx->stats->bytes_rd = bytes_rd;
-		ctx->stats->bytes_wr = bytes_wr;
+	size_t size = ctx->buffer_size;
+	if (ctx->reuse_mode && ctx->region_bytes > 0 && ctx->region_bytes < size)
+		size = ctx->region_bytes;
+	uint64_t lines = size / CACHE_LINE_SIZE;
+	return lines < UINT32_MAX ? lines : UINT32_MAX;
+}
+
+// Sampled latency: rdtscp in tsc_stop() waits for the loads to complete
+static inline vec_t timed_load(worker_ctx_t *ctx, const char *ptr)
+{
+	uint64_t t0 = tsc_start();
+	vec_t	 v	= line_load(ptr);
+	hist_record(ctx->stats->hist, tsc_stop() - t0);
+	return v;
+}
+
+// Sampled latency for a store: the fence waits for it to leave the store
+// buffer, which includes the RFO miss
+static inline void timed_store(worker_ctx_t *ctx, char *ptr, vec_t v)
+{
+	uint64_t t0 = tsc_start();
+	line_store(ptr, v);
+	_mm_mfence();
+	hist_record(ctx->stats->hist, tsc_stop() - t0);
+}
+
+// Sampled latency for a read-modify-write of one line
+static inline vec_t timed_rmw(worker_ctx_t *ctx, char *ptr, vec_t add)
+{
+	uint64_t t0 = tsc_start();
+	vec_t	 v	= line_add(ptr, add);
+	_mm_mfence();
+	hist_record(ctx->stats->hist, tsc_stop() - t0);
+	return v;
+}
+
+enum { OP_READ, OP_WRITE, OP_RW };
+
+// One period of an --rw-ratio mix at random lines of region: the period's
+// offsets are taken from the generator's batches first (*left of the last
+// one unused), then the read-modify-write, read and write runs go over
+// them. ops is the count before the period, for latency sampling.
+// Returns the lines touched.
+static inline __attribute__((always_inline)) uint64_t
+rand_mix_period(worker_ctx_t *ctx, char *region, const rw_mix_t *mix,
+				idx_gen_t *gen, vec_t nv, const idx_stream_t *stream,
+				size_t *pos, int *left, vec_t *acc, vec_t val, uint64_t ops)
+{
+	uint64_t off[2 * MAX_RW_RATIO];
+	uint32_t period	  = mix->rmw + mix->rd + mix->wr;
+	uint64_t lat_mask = ctx->lat_mask;
+
+	for (uint32_t k = 0; k < period;) {
+		if (*left == 0) {
+			idx_batch(gen, nv, stream, pos);
+			*left = IDX_LANES;
+		}
+		uint32_t take = period - k < (uint32_t)*left ? period - k :
+													   (uint32_t)*left;
+		memcpy(&off[k], &gen->off[IDX_LANES - *left], take * sizeof(off[0]));
+		k += take;
+		*left -= (int)take;
+	}
+
+	uint32_t k = 0;
+	for (; k < mix->rmw; k++, ops++) {
+		char *ptr = region + off[k];
+		*acc	  = vec_xor(*acc, (ops & lat_mask) == lat_mask ?
+									  timed_rmw(ctx, ptr, val) :
+									  line_add(ptr, val));
+	}
+	for (; k < mix->rmw + mix->rd; k++, ops++) {
+		char *ptr = region + off[k];
+		*acc	  = vec_xor(*acc, (ops & lat_mask) == lat_mask ?
+									  timed_load(ctx, ptr) :
+									  line_load(ptr));
+	}
+	for (; k < period; k++, ops++) {
+		char *ptr = region + off[k];
+		if ((ops & lat_mask) == lat_mask)
+			timed_store(ctx, ptr, val);
+		else
+			line_store(ptr, val);
 	}
+	return period;
 }
 
-// Random read using AVX-512
-void bench_rand_read(worker_ctx_t *ctx)
+// Shared loop of the random kernels, specialized per op. One op touches one
+// random line of the current region (reuse mode: reuse_iter blocks per
+// region) or of the whole buffer. rand_rw with an --rw-ratio mix goes a
+// period at a time through rand_mix_period instead.
+static inline __attribute__((always_inline)) void
+rand_kernel(worker_ctx_t *ctx, const int op)
 {
-	const char	 *buf		= (const char *)ctx->buffer;
-	size_t		  size		= ctx->buffer_size;
-	size_t		  num_lines = size / CACHE_LINE_SIZE;
-	uint64_t	  ops		= 0;
-	__m512i		  checksum	= _mm512_setzero_si512();
-	prng_state_t *prng		= &ctx->prng;
+	char	*buf	  = (char *)ctx->buffer;
+	size_t	 size	  = ctx->buffer_size;
+	uint64_t ops	  = 0;
+	uint64_t lat_mask = ctx->lat_mask;
+	vec_t	 acc	  = vec_zero();
+	vec_t	 val = op == OP_WRITE ? vec_set1((uint64_t)(ctx->thread_id + 1)) :
+								  vec_set1(1);
 
+	size_t	 region_size = size;
+	size_t	 num_regions = 1;
+	uint64_t passes		 = UINT64_MAX; // blocks per region
 	if (ctx->reuse_mode && ctx->region_bytes > 0) {
-		size_t region_size = ctx->region_bytes < size ? ctx->region_bytes :
-														size;
-		size_t num_regions = size / region_size;
+		region_size = ctx->region_bytes < size ? ctx->region_bytes : size;
+		num_regions = size / region_size;
 		if (num_regions == 0)
 			num_regions = 1;
-		size_t lines_per_region = region_size / CACHE_LINE_SIZE;
-
-		size_t region_idx = 0;
-		while (!should_stop(ctx, ops)) {
-			const char *region = buf + (region_idx % num_regions) * region_size;
-
-			for (uint64_t iter = 0;
-				 iter < ctx->reuse_iter && !should_stop(ctx, ops); iter++) {
-				do {
-					size_t		line_idx = prng_next(prng) % lines_per_region;
-					const char *ptr		 = region + line_idx * CACHE_LINE_SIZE;
-					__m512i		v		 = _mm512_load_si512((const __m512i *)ptr);
-					checksum			 = _mm512_xor_si512(checksum, v);
-					ops++;
-				} while (ops & STATS_UPDATE_MASK);
-				update_stats(ctx, ops, ops * CACHE_LINE_SIZE, 0);
+		passes = ctx->reuse_iter;
+	}
+
+	uint64_t	lines = rand_lines(ctx);
+	vec_t		nv	  = vec_set1(lines);
+	idx_gen_t	gen;
+	size_t		pos	   = 0;
+	const idx_stream_t *stream = (const idx_stream_t *)ctx->priv;
+	if (stream && stream->lines != lines)
+		stream = NULL;
+	idx_seed(&gen, &ctx->prng);
+
+	rw_mix_t mix;
+	int		 mixed = op == OP_RW && bench_rw_mix(ctx, &mix);
+	uint64_t rd	   = 0, wr = 0; // lines read and written
+	int		 left  = 0;			// unused offsets of the last batch
+
+	size_t region_idx = 0;
+	while (lines && !bench_should_stop(ctx, ops)) {
+		char *region = buf + (region_idx % num_regions) * region_size;
+
+		for (uint64_t iter = 0; iter < passes && !bench_should_stop(ctx, ops);
+			 iter++) {
+			// With --iters the last block stops at max_iters, rounded up
+			// to a whole batch or mix period
+			uint64_t end = ops + STATS_UPDATE_MASK + 1;
+			if (end > ctx->max_iters)
+				end = ctx->max_iters;
+			while (mixed && ops < end) {
+				uint64_t n = rand_mix_period(ctx, region, &mix, &gen, nv,
+											 stream, &pos, &left, &acc, val,
+											 ops);
+				ops += n;
+				rd += n - mix.wr;
+				wr += n - mix.rd;
 			}
-			region_idx++;
-		}
-	} else {
-		while (!should_stop(ctx, ops)) {
-			do {
-					size_t		line_idx = prng_next(prng) % num_lines;
-					const char *ptr		 = buf + line_idx * CACHE_LINE_SIZE;
-					__m512i		v		 = _mm512_load_si512((const __m512i *)ptr);
-					checksum			 = _mm512_xor_si512(checksum, v);
-					ops++;
-			} while (ops & STATS_UPDATE_MASK);
-			update_stats(ctx, ops, ops * CACHE_LINE_SIZE, 0);
-			if ((ops & STATS_UPDATE_MASK) == 0 && should_stop(ctx, ops))
-				break;
+			while (!mixed && ops < end) {
+				const uint64_t *off = idx_batch(&gen, nv, stream, &pos);
+				for (int i = 0; i < IDX_LANES; i++, ops++) {
+					char *ptr	= region + off[i];
+					int	  timed = (ops & lat_mask) == lat_mask;
+					if (op == OP_READ) {
+						acc = vec_xor(acc, timed ? timed_load(ctx, ptr) :
+												   line_load(ptr));
+					} else if (op == OP_WRITE) {
+						if (timed)
+							timed_store(ctx, ptr, val);
+						else
+							line_store(ptr, val);
+						val = vec_add(val, vec_set1(1));
+					} else {
+						acc = vec_xor(acc, timed ? timed_rmw(ctx, ptr, val) :
+												   line_add(ptr, val));
+					}
+				}
+				rd += op != OP_WRITE ? IDX_LANES : 0;
+				wr += op != OP_READ ? IDX_LANES : 0;
+			}
+
+			ctx->stats->ops		 = ops;
+			ctx->stats->bytes_rd = rd * CACHE_LINE_SIZE;
+			ctx->stats->bytes_wr = wr * CACHE_LINE_SIZE;
 		}
+		region_idx++;
+	}
+
+	// Index generation alone, same path and thread, for the final stats;
+	// outside the --perf counts, which cover only the measured ops
+	bench_measure_end(ctx);
+	uint64_t t0 = tsc_start();
+	for (int i = 0; i < IDX_CAL_OPS; i += IDX_LANES) {
+		const uint64_t *off = idx_batch(&gen, nv, stream, &pos);
+		__asm__ volatile("" : : "r"(off) : "memory");
 	}
+	ctx->stats->idx_cycles = tsc_stop() - t0;
+	ctx->stats->idx_ops	   = IDX_CAL_OPS;
 
-	uint64_t cs[8];
-	_mm512_storeu_si512((__m512i *)cs, checksum);
-	ctx->stats->checksum = cs[0] ^ cs[1] ^ cs[2] ^ cs[3] ^ cs[4] ^ cs[5] ^
-						   cs[6] ^ cs[7];
+	ctx->stats->checksum = op == OP_WRITE ? vec_first(val) : vec_fold(acc);
 	ctx->stats->ops		 = ops;
-	ctx->stats->bytes_rd = ops * CACHE_LINE_SIZE;
-	ctx->stats->bytes_wr = 0;
+	ctx->stats->bytes_rd = rd * CACHE_LINE_SIZE;
+	ctx->stats->bytes_wr = wr * CACHE_LINE_SIZE;
 }
 
-// Random write using AVX-512
-void bench_rand_write(worker_ctx_t *ctx)
+// Random read, write and read+write (1:1 or --rw-ratio), one line per op
+void KERNEL(rand_read)(worker_ctx_t *ctx)
 {
-	char		 *buf		= (char *)ctx->buffer;
-	size_t		  size		= ctx->buffer_size;
-	size_t		  num_lines = size / CACHE_LINE_SIZE;
-	uint64_t	  ops		= 0;
-	__m512i		  val  = _mm512_set1_epi64((long long)(ctx->thread_id + 1));
-	prng_state_t *prng = &ctx->prng;
+	rand_kernel(ctx, OP_READ);
+}
 
-	if (ctx->reuse_mode && ctx->region_bytes > 0) {
-		size_t region_size = ctx->region_bytes < size ? ctx->region_bytes :
-														size;
-		size_t num_regions = size / region_size;
-		if (num_regions == 0)
-			num_regions = 1;
-		size_t lines_per_region = region_size / CACHE_LINE_SIZE;
-
-		size_t region_idx = 0;
-		while (!should_stop(ctx, ops)) {
-			char *region = buf + (region_idx % num_regions) * region_size;
-
-			for (uint64_t iter = 0;
-				 iter < ctx->reuse_iter && !should_stop(ctx, ops); iter++) {
-				do {
-					size_t line_idx = prng_next(prng) % lines_per_region;
-					char  *ptr		= region + line_idx * CACHE_LINE_SIZE;
-					_mm512_store_si512((__m512i *)ptr, val);
-					val = _mm512_add_epi64(val, _mm512_set1_epi64(1));
-					ops++;
-				} while (ops & STATS_UPDATE_MASK);
-				update_stats(ctx, ops, 0, ops * CACHE_LINE_SIZE);
-			}
-			region_idx++;
-		}
-	} else {
-		while (!should_stop(ctx, ops)) {
-			do {
-				size_t line_idx = prng_next(prng) % num_lines;
-				char  *ptr		= buf + line_idx * CACHE_LINE_SIZE;
-				_mm512_store_si512((__m512i *)ptr, val);
-				val = _mm512_add_epi64(val, _mm512_set1_epi64(1));
-				ops++;
-			} while (ops & STATS_UPDATE_MASK);
-			update_stats(ctx, ops, 0, ops * CACHE_LINE_SIZE);
-			if ((ops & STATS_UPDATE_MASK) == 0 && should_stop(ctx, ops))
-				break;
+void KERNEL(rand_write)(worker_ctx_t *ctx)
+{
+	rand_kernel(ctx, OP_WRITE);
+}
+
+void KERNEL(rand_rw)(worker_ctx_t *ctx)
+{
+	rand_kernel(ctx, OP_RW);
+}
+
+// Prefetch distance of rand_*_pf when --prefetch-dist is not given (ops)
+#define PF_DEFAULT_DIST 64
+
+// Line indices in flight between generation (and prefetch) and use; holds
+// MAX_PREFETCH_DIST plus one generator step
+#define PF_RING 2048
+
+// rand_read/rand_rw with software prefetch: indices are generated dist ops
+// (rounded up to whole generator steps) before their access and prefetched
+// with hint right away, then parked in a ring until their turn. Otherwise
+// the same access, stats and latency sampling as rand_kernel over the
+// whole buffer.
+static inline __attribute__((always_inline)) void
+rand_pf_kernel(worker_ctx_t *ctx, const int op, const int hint)
+{
+	char	*buf	  = (char *)ctx->buffer;
+	uint64_t ops	  = 0;
+	uint64_t lat_mask = ctx->lat_mask;
+	vec_t	 acc	  = vec_zero();
+	vec_t	 val	  = vec_set1(1);
+	uint64_t lines	  = rand_lines(ctx);
+	vec_t	 nv		  = vec_set1(lines);
+	uint32_t ring[PF_RING];
+	size_t	 dist = ctx->prefetch_dist ? ctx->prefetch_dist : PF_DEFAULT_DIST;
+	if (dist > MAX_PREFETCH_DIST)
+		dist = MAX_PREFETCH_DIST;
+	dist = (dist + IDX_LANES - 1) / IDX_LANES * IDX_LANES;
+
+	idx_gen_t gen;
+	idx_seed(&gen, &ctx->prng);
+
+	// Fill the pipeline: the first dist indices are prefetched, not used
+	size_t head = 0, tail = 0;
+	while (lines && head < dist) {
+		idx_next(&gen, nv);
+		for (int i = 0; i < IDX_LANES; i++, head++) {
+			ring[head % PF_RING] = (uint32_t)(gen.off[i] >> 6);
+			bench_prefetch(buf + gen.off[i], hint);
 		}
 	}
 
-	uint64_t cs[8];
-	_mm512_storeu_si512((__m512i *)cs, val);
-	ctx->stats->checksum = cs[0];
+	while (lines && !bench_should_stop(ctx, ops)) {
+		do {
+			idx_next(&gen, nv);
+			for (int i = 0; i < IDX_LANES; i++, head++) {
+				ring[head % PF_RING] = (uint32_t)(gen.off[i] >> 6);
+				bench_prefetch(buf + gen.off[i], hint);
+			}
+			for (int i = 0; i < IDX_LANES; i++, tail++, ops++) {
+				char *ptr	= buf + ((size_t)ring[tail % PF_RING] << 6);
+				int	  timed = (ops & lat_mask) == lat_mask;
+				if (op == OP_READ) {
+					acc = vec_xor(acc, timed ? timed_load(ctx, ptr) :
+											   line_load(ptr));
+				} else {
+					acc = vec_xor(acc, timed ? timed_rmw(ctx, ptr, val) :
+											   line_add(ptr, val));
+				}
+			}
+		} while (ops & STATS_UPDATE_MASK);
+
+		uint64_t bytes		 = ops * CACHE_LINE_SIZE;
+		ctx->stats->ops		 = ops;
+		ctx->stats->bytes_rd = bytes;
+		ctx->stats->bytes_wr = op == OP_RW ? bytes : 0;
+	}
+
+	ctx->stats->checksum = vec_fold(acc);
 	ctx->stats->ops		 = ops;
-	ctx->stats->bytes_rd = 0;
-	ctx->stats->bytes_wr = ops * CACHE_LINE_SIZE;
+	ctx->stats->bytes_rd = ops * CACHE_LINE_SIZE;
+	ctx->stats->bytes_wr = op == OP_RW ? ops * CACHE_LINE_SIZE : 0;
 }
 
-// Random read+write (1:1)
-void bench_rand_rw(worker_ctx_t *ctx)
+// ctx->prefetch picks a specialization; anything else prefetches with t0
+#define RAND_PF_KERNEL(name, op)                     \
+	void KERNEL(name)(worker_ctx_t * ctx)            \
+	{                                                \
+		switch (ctx->prefetch) {                     \
+		case PREFETCH_T2:                            \
+			rand_pf_kernel(ctx, op, PREFETCH_T2);    \
+			break;                                   \
+		case PREFETCH_NTA:                           \
+			rand_pf_kernel(ctx, op, PREFETCH_NTA);   \
+			break;                                   \
+		case PREFETCH_W:                             \
+			rand_pf_kernel(ctx, op, PREFETCH_W);     \
+			break;                                   \
+		default:                                     \
+			rand_pf_kernel(ctx, op, PREFETCH_T0);    \
+		}                                            \
+	}
+
+// Random read and read+write with software prefetch, one line per op
+RAND_PF_KERNEL(rand_read_pf, OP_READ)
+RAND_PF_KERNEL(rand_rw_pf, OP_RW)
+
+// Shared loop of gather_* and scatter_*. Each step picks one group (a line,
+// a 4 KB page or the whole buffer, per --gather-locality) and IDX_LANES
+// random elements inside it. 8-byte elements take one gather or scatter per
+// vector of indices; 64-byte elements take eight, one per word of the line,
+// as when gathering a field-major view of 64-byte records. One op is one
+// element. The avx512 copy uses vpgatherqq/vpscatterqq, avx2 vpgatherqq and
+// one store per lane, sse2 and scalar one load or store per lane.
+static inline __attribute__((always_inline)) void
+gather_kernel(worker_ctx_t *ctx, const int op, const int elem)
 {
-	char		 *buf		= (char *)ctx->buffer;
-	size_t		  size		= ctx->buffer_size;
-	size_t		  num_lines = size / CACHE_LINE_SIZE;
-	uint64_t	  ops		= 0;
-	__m512i		  checksum	= _mm512_setzero_si512();
-	__m512i		  add_val	= _mm512_set1_epi64(1);
-	prng_state_t *prng		= &ctx->prng;
+	char  *buf	= (char *)ctx->buffer;
+	size_t size = ctx->buffer_size;
+	size_t span = ctx->gather_span && ctx->gather_span < size ?
+					  ctx->gather_span :
+					  size;
 
-	if (ctx->reuse_mode && ctx->region_bytes > 0) {
-		size_t region_size = ctx->region_bytes < size ? ctx->region_bytes :
-														size;
-		size_t num_regions = size / region_size;
-		if (num_regions == 0)
-			num_regions = 1;
-		size_t lines_per_region = region_size / CACHE_LINE_SIZE;
-
-		size_t region_idx = 0;
-		while (!should_stop(ctx, ops)) {
-			char *region = buf + (region_idx % num_regions) * region_size;
-
-			for (uint64_t iter = 0;
-				 iter < ctx->reuse_iter && !should_stop(ctx, ops); iter++) {
-				do {
-					size_t	line_idx = prng_next(prng) % lines_per_region;
-					char   *ptr		 = region + line_idx * CACHE_LINE_SIZE;
-					__m512i v		 = _mm512_load_si512((const __m512i *)ptr);
-					v				 = _mm512_add_epi64(v, add_val);
-					_mm512_store_si512((__m512i *)ptr, v);
-					checksum = _mm512_xor_si512(checksum, v);
-					ops++;
-				} while (ops & STATS_UPDATE_MASK);
-				uint64_t bytes = ops * CACHE_LINE_SIZE;
-				update_stats(ctx, ops, bytes, bytes);
+	uint64_t groups = span ? size / span : 0;
+	uint64_t per	= span / (size_t)elem; // elements per group
+	if (groups > UINT32_MAX)
+		groups = UINT32_MAX;
+	if (per > UINT32_MAX)
+		per = UINT32_MAX;
+	const int shift = elem == 8 ? 3 : 6;
+
+	uint64_t  ops = 0;
+	vec_t	  acc = vec_zero();
+	vec_t	  val = vec_set1((uint64_t)(ctx->thread_id + 1));
+	vec_t	  nv  = vec_set1(per);
+	idx_gen_t gen;
+	idx_seed(&gen, &ctx->prng);
+	prng_state_t grp = ctx->prng;
+
+	while (per && !bench_should_stop(ctx, ops)) {
+		do {
+			char *base = buf + (((prng_next(&grp) >> 32) * groups) >> 32) * span;
+			for (int v = 0; v < IDX_VECS; v++) {
+				vec_t off = vec_sll(idx_step(&gen, v, nv), shift);
+				for (int w = 0; w < elem; w += 8) {
+					if (op == OP_READ)
+						acc = vec_xor(acc, vec_gather(base + w, off));
+					else
+						vec_scatter(base + w, off, val);
+				}
 			}
-			region_idx++;
-		}
-	} else {
-		while (!should_stop(ctx, ops)) {
-			do {
-				size_t	line_idx = prng_next(prng) % num_lines;
-				char   *ptr		 = buf + line_idx * CACHE_LINE_SIZE;
-				__m512i v		 = _mm512_load_si512((const __m512i *)ptr);
-				v				 = _mm512_add_epi64(v, add_val);
-				_mm512_store_si512((__m512i *)ptr, v);
-				checksum = _mm512_xor_si512(checksum, v);
-				ops++;
-			} while (ops & STATS_UPDATE_MASK);
-			uint64_t bytes = ops * CACHE_LINE_SIZE;
-			update_stats(ctx, ops, bytes, bytes);
-			if ((ops & STATS_UPDATE_MASK) == 0 && should_stop(ctx, ops))
-				break;
-		}
+			if (op == OP_WRITE)
+				val = vec_add(val, vec_set1(1));
+			ops += IDX_LANES;
+		} while (ops & STATS_UPDATE_MASK);
+
+		ctx->stats->ops		 = ops;
+		ctx->stats->bytes_rd = op == OP_READ ? ops * (uint64_t)elem : 0;
+		ctx->stats->bytes_wr = op == OP_WRITE ? ops * (uint64_t)elem : 0;
 	}
 
-	uint64_t cs[8];
-	_mm512_storeu_si512((__m512i *)cs, checksum);
-	ctx->stats->checksum = cs[0] ^ cs[1] ^ cs[2] ^ cs[3] ^ cs[4] ^ cs[5] ^
-						   cs[6] ^ cs[7];
+	ctx->stats->checksum = op == OP_WRITE ? vec_first(val) : vec_fold(acc);
 	ctx->stats->ops		 = ops;
-	ctx->stats->bytes_rd = ops * CACHE_LINE_SIZE;
-	ctx->stats->bytes_wr = ops * CACHE_LINE_SIZE;
+	ctx->stats->bytes_rd = op == OP_READ ? ops * (uint64_t)elem : 0;
+	ctx->stats->bytes_wr = op == OP_WRITE ? ops * (uint64_t)elem : 0;
 }
+
+// Gather and scatter of 8-byte words and of whole 64-byte lines
+void KERNEL(gather8)(worker_ctx_t *ctx)
+{
+	gather_kernel(ctx, OP_READ, 8);
+}
+
+void KERNEL(gather64)(worker_ctx_t *ctx)
+{
+	gather_kernel(ctx, OP_READ, 64);
+}
+
+void KERNEL(scatter8)(worker_ctx_t *ctx)
+{
+	gather_kernel(ctx, OP_WRITE, 8);
+}
+
+void KERNEL(scatter64)(worker_ctx_t *ctx)
+{
+	gather_kernel(ctx, OP_WRITE, 64);
+}
+
+#ifdef KERNEL_SCALAR
+// ISA-independent, built once with the scalar copy
+
+// Precompute ctx->index_stream indices with the kernels' generator so a
+// run replays them instead of generating; setup only, before timing
+void bench_rand_init(worker_ctx_t *ctx)
+{
+	free(ctx->priv);
+	ctx->priv = NULL;
+
+	uint64_t lines = rand_lines(ctx);
+	size_t	 len   = ctx->index_stream;
+	if (len == 0 || lines == 0)
+		return;
+
+	idx_stream_t *stream =
+		malloc(sizeof(idx_stream_t) + len * sizeof(uint32_t));
+	if (!stream) {
+		fprintf(stderr, "[rand] No memory for a %zu-entry index stream\n",
+				len);
+		return;
+	}
+	stream->lines = lines;
+	stream->len	  = len;
+
+	idx_gen_t	 gen;
+	prng_state_t prng = ctx->prng;
+	idx_seed(&gen, &prng);
+	for (size_t i = 0; i < len; i += IDX_LANES) {
+		idx_next(&gen, vec_set1(lines));
+		for (int j = 0; j < IDX_LANES; j++)
+			stream->idx[i + (size_t)j] = (uint32_t)(gen.off[j] >> 6);
+	}
+	ctx->priv = stream;
+}
+
+#endif // KERNEL_SCALAR
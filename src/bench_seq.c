@@ -1,31 +1,14 @@
 #include <stdio.h>
+#include <stddef.h>
 #include <string.h>
-#include <time.h>
-#include <immintrin.h>
 #include "bench.h"
-
-#define CACHE_LINE_SIZE 64
-#define ZMM_SIZE		64
+#include "vec.h"
 
 // How often to update stats (must be power of 2 - 1)
 #define STATS_UPDATE_MASK 0xFFFF
 
-// Check if we should stop
-static inline int should_stop(worker_ctx_t *ctx, uint64_t ops)
-{
-	if (atomic_load(ctx->stop_flag))
-		return 1;
-
-	if (ctx->stop_mode == STOP_ITERS) {
-		return ops >= ctx->max_iters;
-	} else {
-		struct timespec now;
-		clock_gettime(CLOCK_MONOTONIC, &now);
-		double elapsed = (double)(now.tv_sec - ctx->start_time->tv_sec) +
-						 (double)(now.tv_nsec - ctx->start_time->tv_nsec) / 1e9;
-		return elapsed >= ctx->max_seconds;
-	}
-}
+// Lines between stop checks and stats updates
+#define SPAN_BYTES ((size_t)(STATS_UPDATE_MASK + 1) * CACHE_LINE_SIZE)
 
 // Inline stats update
 static inline void update_stats(worker_ctx_t *ctx, uint64_t ops,
@@ -38,62 +21,418 @@ static inline void update_stats(worker_ctx_t *ctx, uint64_t ops,
 	}
 }
 
-// Sequential read using AVX-512
-void bench_seq_read(worker_ctx_t *ctx)
+enum { OP_READ, OP_WRITE, OP_RW };
+
+// One vector access. acc is the accumulator it feeds; val is the value
+// stored (write) or added (rw).
+static inline __attribute__((always_inline)) void
+access_vec(char *p, vec_t *acc, vec_t val, const int op)
+{
+	if (op == OP_READ) {
+		*acc = vec_xor(*acc, vec_load(p));
+	} else if (op == OP_WRITE) {
+		vec_store(p, val);
+	} else {
+		vec_t v = vec_add(vec_load(p), val);
+		vec_store(p, v);
+		*acc	= vec_xor(*acc, v);
+	}
+}
+
+// Sweep bytes (whole lines) from p with U independent accumulators: each
+// step touches max(U vectors, one line) and vector k feeds acc[k % U], so
+// no dependency chain is longer than one access per U vectors
+static inline __attribute__((always_inline)) void
+access_span(char *p, size_t bytes, vec_t *acc, vec_t val, const int op,
+			const int U)
+{
+	const size_t step = (size_t)U * VEC_BYTES > CACHE_LINE_SIZE ?
+							(size_t)U * VEC_BYTES :
+							CACHE_LINE_SIZE;
+	size_t		 off  = 0;
+
+	for (; off + step <= bytes; off += step) {
+		for (size_t k = 0; k < step / VEC_BYTES; k++)
+			access_vec(p + off + k * VEC_BYTES, &acc[k % (size_t)U], val, op);
+	}
+	for (; off < bytes; off += VEC_BYTES)
+		access_vec(p + off, &acc[0], val, op);
+}
+
+// Lines from p as one run of op: unrolled, or for a throttled generator
+// (delay > 0) one line at a time with delay idle cycles after each
+static inline __attribute__((always_inline)) void
+access_run(char *p, size_t lines, vec_t *acc, vec_t val, const int op,
+		   const int U, uint32_t delay)
+{
+	if (!delay) {
+		access_span(p, lines * CACHE_LINE_SIZE, acc, val, op, U);
+		return;
+	}
+	for (size_t l = 0; l < lines; l++) {
+		access_span(p + l * CACHE_LINE_SIZE, CACHE_LINE_SIZE, acc, val, op, 1);
+		bench_throttle(delay);
+	}
+}
+
+// Lines from p in periods of an --rw-ratio mix, the last period cut short;
+// adds the lines read and written to *rd and *wr. The runs have fixed
+// lengths, so the mix costs no data-dependent branch per line.
+static inline __attribute__((always_inline)) void
+mix_span(char *p, size_t lines, const rw_mix_t *mix, vec_t *acc, vec_t val,
+		 const int U, uint32_t delay, uint64_t *rd, uint64_t *wr)
+{
+	for (size_t l = 0; l < lines;) {
+		size_t a = lines - l < mix->rmw ? lines - l : mix->rmw;
+		access_run(p + l * CACHE_LINE_SIZE, a, acc, val, OP_RW, U, delay);
+		l += a;
+		size_t b = lines - l < mix->rd ? lines - l : mix->rd;
+		access_run(p + l * CACHE_LINE_SIZE, b, acc, val, OP_READ, U, delay);
+		l += b;
+		size_t c = lines - l < mix->wr ? lines - l : mix->wr;
+		access_run(p + l * CACHE_LINE_SIZE, c, acc, val, OP_WRITE, U, delay);
+		l += c;
+		*rd += a + b;
+		*wr += a + c;
+	}
+}
+
+// Shared loop of the sequential kernels, specialized per op and unroll.
+// Walks the whole buffer, or reuse regions reuse_iter times each, in spans
+// of at most SPAN_BYTES with a stop check and stats update after each.
+// A throttled generator (delay > 0) goes one line at a time instead.
+// seq_rw with an --rw-ratio mix goes through mix_span instead.
+static inline __attribute__((always_inline)) void
+seq_kernel(worker_ctx_t *ctx, const int op, const int U)
 {
-	const char *buf		 = (const char *)ctx->buffer;
-	size_t		size	 = ctx->buffer_size;
-	uint64_t	ops		 = 0;
-	__m512i		checksum = _mm512_setzero_si512();
+	char	*buf   = (char *)ctx->buffer;
+	size_t	 size  = ctx->buffer_size / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+	uint64_t ops   = 0;
+	uint32_t delay = ctx->delay;
+	vec_t	 acc[MAX_UNROLL];
+	vec_t	 val = op == OP_WRITE ? vec_set1((uint64_t)(ctx->thread_id + 1)) :
+								  vec_set1(1);
+	rw_mix_t mix;
+	int		 mixed = op == OP_RW && bench_rw_mix(ctx, &mix);
+	uint64_t rd	   = 0, wr = 0; // lines read and written
+
+	for (int k = 0; k < U; k++)
+		acc[k] = vec_zero();
 
+	size_t	 region_size = size;
+	size_t	 num_regions = 1;
+	uint64_t passes		 = UINT64_MAX; // per region
 	if (ctx->reuse_mode && ctx->region_bytes > 0) {
-		size_t region_size = ctx->region_bytes < size ? ctx->region_bytes :
-														size;
-		size_t num_regions = size / region_size;
+		if (ctx->region_bytes < size)
+			region_size = ctx->region_bytes / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+		if (region_size == 0)
+			region_size = CACHE_LINE_SIZE;
+		num_regions = size / region_size;
 		if (num_regions == 0)
 			num_regions = 1;
+		passes = ctx->reuse_iter;
+	}
 
-		size_t region_idx = 0;
-		while (!should_stop(ctx, ops)) {
-			const char *region = buf + (region_idx % num_regions) * region_size;
+	size_t region_idx = 0;
+	while (size && !bench_should_stop(ctx, ops)) {
+		char *region = buf + (region_idx % num_regions) * region_size;
 
-			for (uint64_t iter = 0;
-				 iter < ctx->reuse_iter && !should_stop(ctx, ops); iter++) {
-				for (size_t off = 0; off < region_size; off += ZMM_SIZE) {
-					__m512i v =
-						_mm512_load_si512((const __m512i *)(region + off));
-					checksum = _mm512_xor_si512(checksum, v);
-					ops++;
-					update_stats(ctx, ops, ops * CACHE_LINE_SIZE, 0);
-					if ((ops & STATS_UPDATE_MASK) == 0 && should_stop(ctx, ops))
-						break;
+		for (uint64_t iter = 0; iter < passes && !bench_should_stop(ctx, ops);
+			 iter++) {
+			for (size_t off = 0; off < region_size;) {
+				size_t n = region_size - off;
+				if (n > SPAN_BYTES)
+					n = SPAN_BYTES;
+
+				size_t lines = n / CACHE_LINE_SIZE;
+				if (mixed) {
+					mix_span(region + off, lines, &mix, acc, val, U, delay, &rd,
+							 &wr);
+				} else {
+					access_run(region + off, lines, acc, val, op, U, delay);
+					rd += op != OP_WRITE ? lines : 0;
+					wr += op != OP_READ ? lines : 0;
 				}
+				ops += lines;
+				off += n;
+
+				ctx->stats->ops		 = ops;
+				ctx->stats->bytes_rd = rd * CACHE_LINE_SIZE;
+				ctx->stats->bytes_wr = wr * CACHE_LINE_SIZE;
+				if (bench_should_stop(ctx, ops))
+					break;
 			}
-			region_idx++;
+			if (op == OP_WRITE)
+				val = vec_add(val, vec_set1(1));
 		}
-	} else {
-		while (!should_stop(ctx, ops)) {
-			for (size_t off = 0; off < size; off += ZMM_SIZE) {
-				__m512i v = _mm512_load_si512((const __m512i *)(buf + off));
-				checksum  = _mm512_xor_si512(checksum, v);
-				ops++;
-				update_stats(ctx, ops, ops * CACHE_LINE_SIZE, 0);
-				if ((ops & STATS_UPDATE_MASK) == 0 && should_stop(ctx, ops))
-					break;
+		region_idx++;
+	}
+
+	vec_t sum = vec_zero();
+	for (int k = 0; k < U; k++)
+		sum = vec_xor(sum, acc[k]);
+	ctx->stats->checksum = op == OP_WRITE ? vec_first(val) : vec_fold(sum);
+	ctx->stats->ops		 = ops;
+	ctx->stats->bytes_rd = rd * CACHE_LINE_SIZE;
+	ctx->stats->bytes_wr = wr * CACHE_LINE_SIZE;
+}
+
+// ctx->unroll picks a specialization; anything else runs unrolled by 1
+#define SEQ_KERNEL(name, op)                \
+	void KERNEL(name)(worker_ctx_t * ctx)   \
+	{                                       \
+		switch (ctx->unroll) {              \
+		case 2:                             \
+			seq_kernel(ctx, op, 2);         \
+			break;                          \
+		case 4:                             \
+			seq_kernel(ctx, op, 4);         \
+			break;                          \
+		case 8:                             \
+			seq_kernel(ctx, op, 8);         \
+			break;                          \
+		default:                            \
+			seq_kernel(ctx, op, 1);         \
+		}                                   \
+	}
+
+// Sequential read, write and read+write (1:1 or --rw-ratio), one line per op
+SEQ_KERNEL(seq_read, OP_READ)
+SEQ_KERNEL(seq_write, OP_WRITE)
+SEQ_KERNEL(seq_rw, OP_RW)
+
+enum { STREAM_COPY, STREAM_SCALE, STREAM_ADD, STREAM_TRIAD };
+
+// The q of scale and triad, as in STREAM
+#define STREAM_SCALAR 3.0
+
+// Shared loop of the STREAM kernels over doubles, one op per line of the
+// destination: copy and scale read array 0 into array 1, add and triad read
+// arrays 0 and 1 into array 2. Bytes follow STREAM: each source and the
+// destination once per element, plus (write_allocate) the destination read
+// the cache fetches before a store.
+static inline __attribute__((always_inline)) void
+stream_kernel(worker_ctx_t *ctx, const int kind)
+{
+	const int	twosrc = kind == STREAM_ADD || kind == STREAM_TRIAD;
+	const char *a	   = (const char *)ctx->array[0];
+	const char *b	   = (const char *)ctx->array[1];
+	char	   *dst	   = (char *)ctx->array[twosrc ? 2 : 1];
+	size_t		size   = ctx->buffer_size / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+	uint64_t	rd_op  = (uint64_t)((twosrc ? 2 : 1) + (ctx->write_allocate != 0)) *
+					CACHE_LINE_SIZE;
+	uint64_t	ops	   = 0;
+	vec_t		q	   = vec_fset1(STREAM_SCALAR);
+	vec_t		last   = vec_zero();
+
+	while (size && !bench_should_stop(ctx, ops)) {
+		for (size_t off = 0; off < size;) {
+			size_t n = size - off;
+			if (n > SPAN_BYTES)
+				n = SPAN_BYTES;
+
+			for (size_t end = off + n; off < end; off += VEC_BYTES) {
+				if (kind == STREAM_COPY)
+					last = vec_load(a + off);
+				else if (kind == STREAM_SCALE)
+					last = vec_fmul(q, vec_load(a + off));
+				else if (kind == STREAM_ADD)
+					last = vec_fadd(vec_load(a + off), vec_load(b + off));
+				else
+					last = vec_fadd(vec_load(a + off),
+									vec_fmul(q, vec_load(b + off)));
+				vec_store(dst + off, last);
 			}
+			ops += n / CACHE_LINE_SIZE;
+
+			ctx->stats->ops		 = ops;
+			ctx->stats->bytes_rd = ops * rd_op;
+			ctx->stats->bytes_wr = ops * CACHE_LINE_SIZE;
+			if (bench_should_stop(ctx, ops))
+				break;
 		}
 	}
 
-	uint64_t cs[8];
-	_mm512_storeu_si512((__m512i *)cs, checksum);
-	ctx->stats->checksum = cs[0] ^ cs[1] ^ cs[2] ^ cs[3] ^ cs[4] ^ cs[5] ^
-						   cs[6] ^ cs[7];
+	// The last element stored: 1.0 copy, 3.0 scale and add, 7.0 triad
+	ctx->stats->checksum = vec_first(last);
 	ctx->stats->ops		 = ops;
-	ctx->stats->bytes_rd = ops * CACHE_LINE_SIZE;
-	ctx->stats->bytes_wr = 0;
+	ctx->stats->bytes_rd = ops * rd_op;
+	ctx->stats->bytes_wr = ops * CACHE_LINE_SIZE;
+}
+
+// STREAM copy (c = a), scale (b = q*c), add (c = a+b) and triad
+// (a = b + q*c), with this suite's arrays in place of a, b and c
+void KERNEL(stream_copy)(worker_ctx_t *ctx)
+{
+	stream_kernel(ctx, STREAM_COPY);
+}
+
+void KERNEL(stream_scale)(worker_ctx_t *ctx)
+{
+	stream_kernel(ctx, STREAM_SCALE);
+}
+
+void KERNEL(stream_add)(worker_ctx_t *ctx)
+{
+	stream_kernel(ctx, STREAM_ADD);
+}
+
+void KERNEL(stream_triad)(worker_ctx_t *ctx)
+{
+	stream_kernel(ctx, STREAM_TRIAD);
+}
+
+// How fill_* and copy_* move their bytes
+enum { MOVE_STORE, MOVE_NT, MOVE_REP, MOVE_LIBC };
+
+// Fill n bytes at dst with val (its low byte for rep stosb and memset), or
+// copy them from src
+static inline __attribute__((always_inline)) void
+move_span(char *dst, const char *src, size_t n, vec_t val, const int copy,
+		  const int how)
+{
+	if (how == MOVE_STORE || how == MOVE_NT) {
+		for (size_t off = 0; off < n; off += VEC_BYTES) {
+			vec_t v = copy ? vec_load(src + off) : val;
+			if (how == MOVE_NT)
+				vec_stream(dst + off, v);
+			else
+				vec_store(dst + off, v);
+		}
+		if (how == MOVE_NT)
+			vec_sfence();
+	} else if (how == MOVE_REP) {
+		if (copy)
+			__asm__ volatile("rep movsb"
+							 : "+D"(dst), "+S"(src), "+c"(n)
+							 :
+							 : "memory");
+		else
+			__asm__ volatile("rep stosb"
+							 : "+D"(dst), "+c"(n)
+							 : "a"((uint8_t)vec_first(val))
+							 : "memory");
+	} else if (copy) {
+		memcpy(dst, src, n);
+	} else {
+		memset(dst, (uint8_t)vec_first(val), n);
+	}
+}
+
+// Shared loop of the fill and copy kernels: the whole buffer (copy: array 0
+// into array 1) in spans of at most SPAN_BYTES, one op per line, with a stop
+// check and stats update after each span. Non-temporal spans end with an
+// sfence, so their stores have left the core before the stop check.
+static inline __attribute__((always_inline)) void
+move_kernel(worker_ctx_t *ctx, const int copy, const int how)
+{
+	char	   *dst	 = (char *)(copy ? ctx->array[1] : ctx->buffer);
+	const char *src	 = (const char *)ctx->array[0];
+	size_t		size = ctx->buffer_size / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+	uint64_t	ops	 = 0;
+	vec_t		val	 = vec_set1(UINT64_C(0x0101010101010101) *
+								(uint64_t)(ctx->thread_id + 1));
+
+	while (size && !bench_should_stop(ctx, ops)) {
+		for (size_t off = 0; off < size;) {
+			size_t n = size - off;
+			if (n > SPAN_BYTES)
+				n = SPAN_BYTES;
+
+			move_span(dst + off, src + off, n, val, copy, how);
+			ops += n / CACHE_LINE_SIZE;
+			off += n;
+
+			ctx->stats->ops		 = ops;
+			ctx->stats->bytes_rd = copy ? ops * CACHE_LINE_SIZE : 0;
+			ctx->stats->bytes_wr = ops * CACHE_LINE_SIZE;
+			if (bench_should_stop(ctx, ops))
+				break;
+		}
+	}
+
+	uint64_t first;
+	memcpy(&first, dst, sizeof(first));
+	ctx->stats->checksum = size ? first : 0;
+	ctx->stats->ops		 = ops;
+	ctx->stats->bytes_rd = copy ? ops * CACHE_LINE_SIZE : 0;
+	ctx->stats->bytes_wr = ops * CACHE_LINE_SIZE;
+}
+
+// Fill and copy with cached vector stores and with non-temporal ones
+void KERNEL(fill_store)(worker_ctx_t *ctx)
+{
+	move_kernel(ctx, 0, MOVE_STORE);
+}
+
+void KERNEL(fill_nt)(worker_ctx_t *ctx)
+{
+	move_kernel(ctx, 0, MOVE_NT);
+}
+
+void KERNEL(copy_store)(worker_ctx_t *ctx)
+{
+	move_kernel(ctx, 1, MOVE_STORE);
+}
+
+void KERNEL(copy_nt)(worker_ctx_t *ctx)
+{
+	move_kernel(ctx, 1, MOVE_NT);
+}
+
+// Setup fill: word i of base gets seed ^ i, for i in [offset, offset +
+// size) / 8, one vector store at a time after a scalar head up to vector
+// alignment. Plain stores beat streaming stores here: the page fault has
+// just zeroed the page, so its lines are already in cache.
+void KERNEL(fill_pattern)(void *base, size_t offset, size_t size,
+						  uint64_t seed)
+{
+	enum { LANES = VEC_BYTES / sizeof(uint64_t) };
+	uint64_t *p	  = (uint64_t *)base;
+	size_t	  i	  = offset / sizeof(uint64_t);
+	size_t	  end = (offset + size) / sizeof(uint64_t);
+
+	while (i < end && ((uintptr_t)&p[i] & (VEC_BYTES - 1))) {
+		p[i] = seed ^ (uint64_t)i;
+		i++;
+	}
+
+	_Alignas(VEC_BYTES) uint64_t lane[LANES];
+	for (size_t k = 0; k < LANES; k++)
+		lane[k] = (uint64_t)(i + k);
+	vec_t idx  = vec_load(lane);
+	vec_t vs   = vec_set1(seed);
+	vec_t step = vec_set1(LANES);
+	for (; i + LANES <= end; i += LANES) {
+		vec_store(&p[i], vec_xor(vs, idx));
+		idx = vec_add(idx, step);
+	}
+
+	for (; i < end; i++)
+		p[i] = seed ^ (uint64_t)i;
 }
 
-// Sequential read using scalar 8-byte loads (no AVX)
+#ifdef KERNEL_SCALAR
+// ISA-independent benchmarks, built once with the scalar copy
+
+// STREAM's starting values: 1.0 in the first array, 2.0 in the second, 0.0
+// in the third. Overwrites the fill pattern, whose words as doubles would
+// include denormals (slow on every x86 core).
+void bench_stream_init(worker_ctx_t *ctx)
+{
+	static const double init[BENCH_MAX_ARRAYS] = { 1.0, 2.0, 0.0 };
+	size_t				count = ctx->buffer_size / sizeof(double);
+
+	for (int k = 0; k < BENCH_MAX_ARRAYS; k++) {
+		double *p = (double *)ctx->array[k];
+		if (!p)
+			continue;
+		for (size_t i = 0; i < count; i++)
+			p[i] = init[k];
+	}
+}
+
+// Sequential read using scalar 8-byte loads, one op per word
 void bench_seq_read_scalar(worker_ctx_t *ctx)
 {
 	const uint64_t *buf	  = (const uint64_t *)ctx->buffer;
@@ -110,29 +449,29 @@ void bench_seq_read_scalar(worker_ctx_t *ctx)
 			num_regions = 1;
 
 		size_t region_idx = 0;
-		while (!should_stop(ctx, ops)) {
+		while (!bench_should_stop(ctx, ops)) {
 			const uint64_t *region =
 				buf + (region_idx % num_regions) * region_count;
 
 			for (uint64_t iter = 0;
-				 iter < ctx->reuse_iter && !should_stop(ctx, ops); iter++) {
+				 iter < ctx->reuse_iter && !bench_should_stop(ctx, ops); iter++) {
 				for (size_t i = 0; i < region_count; i++) {
 					sum += region[i];
 					ops++;
 					update_stats(ctx, ops, ops * sizeof(uint64_t), 0);
-					if ((ops & STATS_UPDATE_MASK) == 0 && should_stop(ctx, ops))
+					if ((ops & STATS_UPDATE_MASK) == 0 && bench_should_stop(ctx, ops))
 						break;
 				}
 			}
 			region_idx++;
 		}
 	} else {
-		while (!should_stop(ctx, ops)) {
+		while (!bench_should_stop(ctx, ops)) {
 			for (size_t i = 0; i < count; i++) {
 				sum += buf[i];
 				ops++;
 				update_stats(ctx, ops, ops * sizeof(uint64_t), 0);
-				if ((ops & STATS_UPDATE_MASK) == 0 && should_stop(ctx, ops))
+				if ((ops & STATS_UPDATE_MASK) == 0 && bench_should_stop(ctx, ops))
 					break;
 			}
 		}
@@ -144,117 +483,115 @@ void bench_seq_read_scalar(worker_ctx_t *ctx)
 	ctx->stats->bytes_wr = 0;
 }
 
-// Sequential write using AVX-512
-void bench_seq_write(worker_ctx_t *ctx)
+// Shared loop of the strided kernels: one 8-byte word every ctx->stride
+// bytes, ascending or (ctx->backward) descending through the buffer, one
+// op per word. Bytes count the words; lines counts the lines they sit in,
+// so the two bandwidths part once the stride passes a line.
+static inline __attribute__((always_inline)) void
+stride_kernel(worker_ctx_t *ctx, const int op)
 {
-	char	*buf  = (char *)ctx->buffer;
-	size_t	 size = ctx->buffer_size;
-	uint64_t ops  = 0;
-	__m512i	 val  = _mm512_set1_epi64((long long)(ctx->thread_id + 1));
+	size_t	 stride = ctx->stride;
+	size_t	 count	= ctx->buffer_size / stride; // words per pass
+	ptrdiff_t step	= ctx->backward ? -(ptrdiff_t)stride : (ptrdiff_t)stride;
+	char	*first	= (char *)ctx->buffer +
+				   (ctx->backward && count ? (count - 1) * stride : 0);
+	uint64_t ops = 0;
+	uint64_t acc = 0;
+	uint64_t val = op == OP_WRITE ? (uint64_t)(ctx->thread_id + 1) : 1;
 
-	if (ctx->reuse_mode && ctx->region_bytes > 0) {
-		size_t region_size = ctx->region_bytes < size ? ctx->region_bytes :
-														size;
-		size_t num_regions = size / region_size;
-		if (num_regions == 0)
-			num_regions = 1;
-
-		size_t region_idx = 0;
-		while (!should_stop(ctx, ops)) {
-			char *region = buf + (region_idx % num_regions) * region_size;
+	while (count && !bench_should_stop(ctx, ops)) {
+		char *p = first;
+		for (size_t i = 0; i < count;) {
+			size_t n = count - i;
+			if (n > STATS_UPDATE_MASK + 1)
+				n = STATS_UPDATE_MASK + 1;
 
-			for (uint64_t iter = 0;
-				 iter < ctx->reuse_iter && !should_stop(ctx, ops); iter++) {
-				for (size_t off = 0; off < region_size; off += ZMM_SIZE) {
-					_mm512_store_si512((__m512i *)(region + off), val);
-					ops++;
-					update_stats(ctx, ops, 0, ops * CACHE_LINE_SIZE);
-					if ((ops & STATS_UPDATE_MASK) == 0 && should_stop(ctx, ops))
-						break;
+			for (size_t end = i + n; i < end; i++, p += step) {
+				uint64_t *w = (uint64_t *)p;
+				if (op == OP_READ) {
+					acc ^= *w;
+				} else if (op == OP_WRITE) {
+					*w = val;
+				} else {
+					*w += val;
+					acc ^= *w;
 				}
-				val = _mm512_add_epi64(val, _mm512_set1_epi64(1));
-			}
-			region_idx++;
-		}
-	} else {
-		while (!should_stop(ctx, ops)) {
-			for (size_t off = 0; off < size; off += ZMM_SIZE) {
-				_mm512_store_si512((__m512i *)(buf + off), val);
-				ops++;
-				update_stats(ctx, ops, 0, ops * CACHE_LINE_SIZE);
-				if ((ops & STATS_UPDATE_MASK) == 0 && should_stop(ctx, ops))
-					break;
 			}
-			val = _mm512_add_epi64(val, _mm512_set1_epi64(1));
+			ops += n;
+
+			ctx->stats->ops		 = ops;
+			ctx->stats->bytes_rd = op != OP_WRITE ? ops * sizeof(uint64_t) : 0;
+			ctx->stats->bytes_wr = op != OP_READ ? ops * sizeof(uint64_t) : 0;
+			ctx->stats->lines	 = stride >= CACHE_LINE_SIZE ?
+									   ops :
+									   ops * stride / CACHE_LINE_SIZE;
+			if (bench_should_stop(ctx, ops))
+				break;
 		}
+		if (op == OP_WRITE)
+			val++;
 	}
 
-	uint64_t cs[8];
-	_mm512_storeu_si512((__m512i *)cs, val);
-	ctx->stats->checksum = cs[0];
-	ctx->stats->ops		 = ops;
-	ctx->stats->bytes_rd = 0;
-	ctx->stats->bytes_wr = ops * CACHE_LINE_SIZE;
+	ctx->stats->checksum = op == OP_WRITE ? val : acc;
 }
 
-// Sequential read+write (1:1)
-void bench_seq_rw(worker_ctx_t *ctx)
+// Strided read, write and read+write (1:1) of one word per --stride
+void bench_stride_read(worker_ctx_t *ctx)
 {
-	char	*buf	  = (char *)ctx->buffer;
-	size_t	 size	  = ctx->buffer_size;
-	uint64_t ops	  = 0;
-	__m512i	 checksum = _mm512_setzero_si512();
-	__m512i	 add_val  = _mm512_set1_epi64(1);
+	stride_kernel(ctx, OP_READ);
+}
 
-	if (ctx->reuse_mode && ctx->region_bytes > 0) {
-		size_t region_size = ctx->region_bytes < size ? ctx->region_bytes :
-														size;
-		size_t num_regions = size / region_size;
-		if (num_regions == 0)
-			num_regions = 1;
+void bench_stride_write(worker_ctx_t *ctx)
+{
+	stride_kernel(ctx, OP_WRITE);
+}
 
-		size_t region_idx = 0;
-		while (!should_stop(ctx, ops)) {
-			char *region = buf + (region_idx % num_regions) * region_size;
+void bench_stride_rw(worker_ctx_t *ctx)
+{
+	stride_kernel(ctx, OP_RW);
+}
 
-			for (uint64_t iter = 0;
-				 iter < ctx->reuse_iter && !should_stop(ctx, ops); iter++) {
-				for (size_t off = 0; off < region_size; off += ZMM_SIZE) {
-					__m512i v =
-						_mm512_load_si512((const __m512i *)(region + off));
-					v = _mm512_add_epi64(v, add_val);
-					_mm512_store_si512((__m512i *)(region + off), v);
-					checksum = _mm512_xor_si512(checksum, v);
-					ops++;
-					uint64_t bytes = ops * CACHE_LINE_SIZE;
-					update_stats(ctx, ops, bytes, bytes);
-					if ((ops & STATS_UPDATE_MASK) == 0 && should_stop(ctx, ops))
-						break;
-				}
-			}
-			region_idx++;
-		}
-	} else {
-		while (!should_stop(ctx, ops)) {
-			for (size_t off = 0; off < size; off += ZMM_SIZE) {
-				__m512i v = _mm512_load_si512((const __m512i *)(buf + off));
-				v		  = _mm512_add_epi64(v, add_val);
-				_mm512_store_si512((__m512i *)(buf + off), v);
-				checksum = _mm512_xor_si512(checksum, v);
-				ops++;
-				uint64_t bytes = ops * CACHE_LINE_SIZE;
-				update_stats(ctx, ops, bytes, bytes);
-				if ((ops & STATS_UPDATE_MASK) == 0 && should_stop(ctx, ops))
-					break;
-			}
-		}
+// Fill and copy with rep stosb / rep movsb (ERMS, FSRM) and with glibc's
+// memset / memcpy, which pick their own strategy by size
+void bench_fill_stosb(worker_ctx_t *ctx)
+{
+	move_kernel(ctx, 0, MOVE_REP);
+}
+
+void bench_fill_memset(worker_ctx_t *ctx)
+{
+	move_kernel(ctx, 0, MOVE_LIBC);
+}
+
+void bench_copy_movsb(worker_ctx_t *ctx)
+{
+	move_kernel(ctx, 1, MOVE_REP);
+}
+
+void bench_copy_memcpy(worker_ctx_t *ctx)
+{
+	move_kernel(ctx, 1, MOVE_LIBC);
+}
+
+// Harness only: the same block loop, stats updates and stop checks as the
+// kernels above with no memory access, so ops/s bounds what the framework
+// itself allows and 1/ops_per_sec is its per-op overhead
+void bench_nop(worker_ctx_t *ctx)
+{
+	uint64_t ops = 0;
+
+	while (!bench_should_stop(ctx, ops)) {
+		do {
+			ops++;
+			__asm__ volatile("" : "+r"(ops));
+		} while (ops & STATS_UPDATE_MASK);
+		update_stats(ctx, ops, 0, 0);
 	}
 
-	uint64_t cs[8];
-	_mm512_storeu_si512((__m512i *)cs, checksum);
-	ctx->stats->checksum = cs[0] ^ cs[1] ^ cs[2] ^ cs[3] ^ cs[4] ^ cs[5] ^
-						   cs[6] ^ cs[7];
 	ctx->stats->ops		 = ops;
-	ctx->stats->bytes_rd = ops * CACHE_LINE_SIZE;
-	ctx->stats->bytes_wr = ops * CACHE_LINE_SIZE;
+	ctx->stats->bytes_rd = 0;
+	ctx->stats->bytes_wr = 0;
+	ctx->stats->checksum = ops;
 }
+
+#endif // KERNEL_SCALAR
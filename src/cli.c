@@ -4,6 +4,8 @@
 #include <getopt.h>
 #include <ctype.h>
 #include "cli.h"
+#include "topology.h"
+#include "isa.h"
 
 void cli_init_defaults(cli_args_t *args)
 {
@@ -17,9 +19,174 @@ void cli_init_defaults(cli_args_t *args)
 	args->region_bytes	  = 2 * 1024 * 1024; // 2 MB default
 	args->reuse_iter	  = 50000;
 	args->seed			  = 0x12345678DEADBEEFULL;
-	args->pin			  = 0;
+	args->pin			  = PIN_NONE;
 	args->report_interval = 1.0;
 	args->bench_count	  = 0;
+	args->numa[0].policy  = NUMA_LOCAL;
+	args->numa[0].nodes	  = 0;
+	args->numa_count	  = 0;
+	args->pages			  = PAGES_4K;
+	args->lat_sample	  = 1024;
+	args->sweep_steps	  = 2;
+	args->isa			  = ISA_AUTO;
+	args->stride		  = 64;
+	args->ring_slots	  = 1024;
+}
+
+const numa_spec_t *cli_numa_spec(const cli_args_t *args, int index)
+{
+	// Workloads without their own --numa use the first one
+	if (index < args->numa_count)
+		return &args->numa[index];
+	return &args->numa[0];
+}
+
+const char *cli_mode_name(run_mode_t mode)
+{
+	switch (mode) {
+	case MODE_SINGLE:
+		return "single";
+	case MODE_SEQ:
+		return "seq";
+	case MODE_CONCURRENT:
+		return "concurrent";
+	case MODE_MLP:
+		return "mlp";
+	case MODE_LOADED:
+		return "loaded-latency";
+	case MODE_SIZES:
+		return "size-sweep";
+	case MODE_SCALING:
+		return "scaling";
+	case MODE_WIDTH:
+		return "width";
+	case MODE_TLB:
+		return "tlb";
+	case MODE_PREFETCH:
+		return "prefetch";
+	case MODE_STORES:
+		return "stores";
+	case MODE_C2C:
+		return "c2c";
+	case MODE_QUEUE:
+		return "queue";
+	}
+	return "unknown";
+}
+
+const char *cli_numa_policy_name(numa_policy_t policy)
+{
+	switch (policy) {
+	case NUMA_LOCAL:
+		return "local";
+	case NUMA_BIND:
+		return "bind";
+	case NUMA_INTERLEAVE:
+		return "interleave";
+	case NUMA_PREFERRED:
+		return "preferred";
+	case NUMA_WEIGHTED:
+		return "weighted";
+	}
+	return "unknown";
+}
+
+const char *cli_page_mode_name(page_mode_t mode)
+{
+	switch (mode) {
+	case PAGES_4K:
+		return "4k";
+	case PAGES_THP:
+		return "thp";
+	case PAGES_HUGETLB_2M:
+		return "hugetlb-2M";
+	case PAGES_HUGETLB_1G:
+		return "hugetlb-1G";
+	case PAGES_AUTO:
+		return "auto";
+	}
+	return "unknown";
+}
+
+static const char *const prefetch_names[PREFETCH_COUNT] = { "t0", "t2",
+															"nta", "w" };
+
+const char *cli_prefetch_name(prefetch_t hint)
+{
+	return hint < PREFETCH_COUNT ? prefetch_names[hint] : "unknown";
+}
+
+// Parse a list of prefetch hints, e.g. "t0,nta", or "all"
+static int parse_prefetch_list(const char *str, cli_args_t *args)
+{
+	char buf[64];
+	strncpy(buf, str, sizeof(buf) - 1);
+	buf[sizeof(buf) - 1] = '\0';
+
+	args->prefetch_count = 0;
+	if (strcmp(buf, "all") == 0) {
+		for (int h = 0; h < PREFETCH_COUNT; h++)
+			args->prefetch[args->prefetch_count++] = (prefetch_t)h;
+		return 0;
+	}
+
+	for (char *tok = strtok(buf, ","); tok; tok = strtok(NULL, ",")) {
+		int h = 0;
+		while (h < PREFETCH_COUNT && strcmp(tok, prefetch_names[h]) != 0)
+			h++;
+		if (h == PREFETCH_COUNT || args->prefetch_count >= PREFETCH_COUNT)
+			return -1;
+		args->prefetch[args->prefetch_count++] = (prefetch_t)h;
+	}
+	return args->prefetch_count > 0 ? 0 : -1;
+}
+
+// Parse <policy>[:<nodes>], e.g. "bind:1" or "interleave:0-3"
+static int parse_numa_spec(const char *str, numa_spec_t *spec)
+{
+	char		name[32];
+	const char *colon = strchr(str, ':');
+	size_t		len	  = colon ? (size_t)(colon - str) : strlen(str);
+	if (len >= sizeof(name))
+		return -1;
+	memcpy(name, str, len);
+	name[len] = '\0';
+
+	if (strcmp(name, "local") == 0) {
+		spec->policy = NUMA_LOCAL;
+	} else if (strcmp(name, "bind") == 0) {
+		spec->policy = NUMA_BIND;
+	} else if (strcmp(name, "interleave") == 0) {
+		spec->policy = NUMA_INTERLEAVE;
+	} else if (strcmp(name, "preferred") == 0) {
+		spec->policy = NUMA_PREFERRED;
+	} else if (strcmp(name, "weighted") == 0) {
+		spec->policy = NUMA_WEIGHTED;
+	} else {
+		return -1;
+	}
+
+	spec->nodes = 0;
+	if (colon) {
+		int nodes[MAX_NUMA_NODES];
+		int n = topo_parse_cpulist(colon + 1, nodes, MAX_NUMA_NODES);
+		if (n <= 0)
+			return -1;
+		for (int i = 0; i < n; i++) {
+			if (nodes[i] >= MAX_NUMA_NODES)
+				return -1;
+			spec->nodes |= 1ULL << nodes[i];
+		}
+	}
+
+	// bind and preferred need an explicit node
+	if ((spec->policy == NUMA_BIND || spec->policy == NUMA_PREFERRED) &&
+		spec->nodes == 0)
+		return -1;
+	if (spec->policy == NUMA_LOCAL && spec->nodes != 0)
+		return -1;
+
+	return 0;
 }
 
 static size_t parse_size(const char *str)
@@ -42,6 +209,105 @@ static size_t parse_size(const char *str)
 	return (size_t)val;
 }
 
+// Parse a list of positive integers with ranges, e.g. "1-4,8,16"
+static int parse_int_list(const char *str, int min, int *out, int max)
+{
+	int			count = 0;
+	const char *p	  = str;
+
+	while (*p) {
+		while (*p == ' ' || *p == ',')
+			p++;
+		if (!*p)
+			break;
+
+		char *end;
+		long  lo = strtol(p, &end, 10);
+		long  hi = lo;
+		if (end == p)
+			return -1;
+		if (*end == '-') {
+			hi = strtol(end + 1, &end, 10);
+		}
+		if (lo < min || hi < lo)
+			return -1;
+
+		for (long v = lo; v <= hi; v++) {
+			if (count >= max)
+				return -1;
+			out[count++] = (int)v;
+		}
+		p = end;
+	}
+
+	return count;
+}
+
+// Parse a list of sizes, e.g. "8,64,1K,4K"
+static int parse_size_list(const char *str, size_t *out, int max)
+{
+	char buf[256];
+	strncpy(buf, str, sizeof(buf) - 1);
+	buf[sizeof(buf) - 1] = '\0';
+
+	int count = 0;
+	for (char *tok = strtok(buf, ","); tok; tok = strtok(NULL, ",")) {
+		if (count >= max)
+			return -1;
+		out[count] = parse_size(tok);
+		if (out[count] == 0)
+			return -1;
+		count++;
+	}
+	return count;
+}
+
+// Parse an R:W read:write mix, e.g. "3:1"; each side 0-MAX_RW_RATIO
+static int parse_rw_ratio(const char *str, cli_args_t *args)
+{
+	char *end;
+	long  r = strtol(str, &end, 10);
+	if (end == str || *end != ':')
+		return -1;
+
+	const char *w_str = end + 1;
+	long		w	  = strtol(w_str, &end, 10);
+	if (end == w_str || *end || r < 0 || w < 0 || r + w == 0 ||
+		r > MAX_RW_RATIO || w > MAX_RW_RATIO)
+		return -1;
+
+	args->rw_read  = (uint32_t)r;
+	args->rw_write = (uint32_t)w;
+	return 0;
+}
+
+// Parse <min>:<max>[:<steps>], e.g. "4K:1G" or "16K:256M:4"
+static int parse_size_range(const char *str, cli_args_t *args)
+{
+	char buf[64];
+	strncpy(buf, str, sizeof(buf) - 1);
+	buf[sizeof(buf) - 1] = '\0';
+
+	char *max = strchr(buf, ':');
+	if (!max)
+		return -1;
+	*max++ = '\0';
+
+	char *steps = strchr(max, ':');
+	if (steps) {
+		*steps++		  = '\0';
+		args->sweep_steps = atoi(steps);
+		if (args->sweep_steps < 1)
+			return -1;
+	}
+
+	args->sweep_min = parse_size(buf);
+	args->sweep_max = parse_size(max);
+	if (args->sweep_min == 0 || args->sweep_max < args->sweep_min)
+		return -1;
+	return 0;
+}
+
 static int parse_bench_list(const char *str, cli_args_t *args)
 {
 	char buf[512];
@@ -69,21 +335,106 @@ void cli_usage(const char *prog)
 		stderr,
 		"Usage: %s [OPTIONS]\n\n"
 		"Execution Modes:\n"
-		"  --mode <single|seq|concurrent>   Run mode (default: single)\n"
-		"  --bench <name>                   Benchmark for single mode\n"
+		"  --mode <single|seq|concurrent|mlp|loaded-latency|size-sweep|scaling|\n"
+		"          width|tlb|prefetch|stores|c2c|queue>\n"
+		"                                   Run mode (default: single)\n"
+		"  --bench <name>                   Benchmark for single mode; bandwidth\n"
+		"                                   generator for loaded-latency (seq_*)\n"
 		"  --benches <list>                 Comma-separated benchmarks for seq/concurrent\n\n"
 		"Stop Conditions:\n"
 		"  --seconds <T>                    Run for T seconds (default: 5)\n"
 		"  --iters <N>                      Run for N operations\n\n"
 		"Buffer Settings:\n"
 		"  --size <bytes>                   Buffer size per benchmark (default: 64M)\n"
-		"  --threads <N>                    Threads per benchmark (default: 4)\n\n"
+		"  --threads <N>                    Threads per benchmark (default: 4)\n"
+		"  --pages <mode>                   4k, thp, hugetlb-2M, hugetlb-1G, auto\n"
+		"                                   (default: 4k)\n\n"
+		"Pointer Chase Options:\n"
+		"  --chains <list>                  ptr_chase_mlp chain counts, 1-32; mlp mode\n"
+		"                                   sweeps the list, other modes use the first\n"
+		"                                   (default: 8; mlp sweep 1-8,10,12,...,32)\n\n"
+		"Loaded Latency Options:\n"
+		"  --delays <list>                  Generator delays in cycles per line, high\n"
+		"                                   to low load (default: 10000,...,20,0)\n\n"
+		"Size Sweep Options:\n"
+		"  --sizes <min>:<max>[:<steps>]    Geometric working-set sizes, <steps> per\n"
+		"                                   doubling (default: 4K:<size>:2; tlb mode:\n"
+		"                                   8 pages per thread to <size>)\n\n"
+		"Scaling Options:\n"
+		"  --thread-list <list>             Thread counts to run, e.g. 1-8,12,16\n"
+		"                                   (default: 1 to --threads)\n\n"
+		"Random Index Options (rand_*):\n"
+		"  --index-stream <N>               Replay N precomputed indices per thread\n"
+		"                                   (rounded up to a power of 2) instead of\n"
+		"                                   generating them while running (default: 0)\n\n"
+		"Gather/Scatter Options (gather*, scatter*):\n"
+		"  --gather-locality <where>        Each step's 8 indices fall in one random\n"
+		"                                   line, page (4K) or anywhere in the buffer\n"
+		"                                   (random) (default: random)\n\n"
+		"Stride Options (stride_*):\n"
+		"  --stride <bytes>                 Bytes between accessed 8-byte words, a\n"
+		"                                   multiple of 8 (default: 64)\n"
+		"  --direction <forward|backward>   Ascending or descending walk\n"
+		"                                   (default: forward)\n\n"
+		"Prefetch Options (*_pf):\n"
+		"  --prefetch <list>                Hints from t0,t2,nta,w or all; prefetch\n"
+		"                                   mode sweeps the list, other modes use the\n"
+		"                                   first (default: t0; sweep all)\n"
+		"  --prefetch-dist <list>           Ops ahead (rand_*_pf) or hops ahead\n"
+		"                                   (ptr_chase_pf), 1-1024 (default: 64 or 2;\n"
+		"                                   sweep 8-256 or 2-16 by doubling)\n\n"
+		"STREAM Options (stream_*):\n"
+		"  --write-allocate                 Also count the line each store reads\n"
+		"                                   first (read for ownership) as read bytes\n\n"
+		"Read/Write Mix (seq_rw, rand_rw):\n"
+		"  --rw-ratio <R:W>                 Lines read : lines written, each 0-64,\n"
+		"                                   e.g. 3:1; writes hit the lines just read\n"
+		"                                   (default: 1:1 read-modify-write)\n"
+		"  --rw-other                       Write other lines than the reads (R + W\n"
+		"                                   lines per period)\n\n"
+		"Atomic Options (atomic_*):\n"
+		"  --atomic-delay <cycles>          Idle cycles after each atomic op; higher\n"
+		"                                   means less contention (default: 0)\n\n"
+		"Ring Options (*_ring):\n"
+		"  --msg-size <list>                Message bytes, multiples of 8 from 8 to\n"
+		"                                   4K; queue mode sweeps the list, other\n"
+		"                                   modes use the first (default: 64;\n"
+		"                                   sweep 8,64,256,1K,4K)\n"
+		"  --ring-slots <N>                 Slots per ring, a power of 2 (default:\n"
+		"                                   1024, fewer if --size is too small)\n\n"
+		"Latency Sampling (ptr_chase, rand_*, *_ring):\n"
+		"  --lat-sample <N>                 Time 1 in N ops with the TSC, rounded up\n"
+		"                                   to a power of 2; 0 disables (default: 1024)\n\n"
 		"Reuse Mode Options (for *_reuse benchmarks):\n"
 		"  --region-bytes <bytes>           Region size for reuse (default: 2M)\n"
 		"  --reuse-iter <N>                 Iterations per region (default: 50000)\n\n"
+		"CPU Pinning:\n"
+		"  --pin <policy>                   none, compact, scatter, core (default: none)\n"
+		"                                   (1 = compact, 0 = none)\n"
+		"  --cpus <list>                    Pin to explicit CPUs, e.g. 0-3,8\n"
+		"  --share-cpus                     Let concurrent workloads share CPUs\n\n"
+		"NUMA Placement:\n"
+		"  --numa <policy>                  local, bind:<nodes>, interleave[:<nodes>],\n"
+		"                                   preferred:<node>, weighted[:<nodes>]\n"
+		"                                   (default: local; repeat per workload)\n\n"
+		"Output:\n"
+		"  --format <text|json|csv>         Stats record format (default: text)\n"
+		"  --output <file>                  Write records to file (default: stdout;\n"
+		"                                   json/csv move other output to stderr)\n\n"
+		"Kernels:\n"
+		"  --isa <name>                     auto, avx512, avx2, sse2, scalar; kernel\n"
+		"                                   width for seq_* and rand_* (default: auto,\n"
+		"                                   the widest the CPU supports)\n"
+		"  --unroll <list>                  Independent accumulators in seq_*, from\n"
+		"                                   1,2,4,8; width mode sweeps the list, other\n"
+		"                                   modes use the first (default: 1; width\n"
+		"                                   sweep 1,2,4,8)\n\n"
+		"Counters:\n"
+		"  --perf                           Count cycles, instructions, LLC, L1D,\n"
+		"                                   dTLB and DRAM-read events per thread\n"
+		"                                   during the run; report them per op\n\n"
 		"Other:\n"
 		"  --seed <N>                       PRNG seed\n"
-		"  --pin <0|1>                      CPU pinning (default: 0)\n"
 		"  --report-interval <sec>          Reporting interval (default: 1.0)\n"
 		"  --help                           Show this help\n\n"
 		"Available benchmarks:\n"
@@ -91,12 +442,36 @@ void cli_usage(const char *prog)
 		"  seq_read_reuse, seq_write_reuse, seq_rw_reuse\n"
 		"  rand_read, rand_write, rand_rw\n"
 		"  rand_read_reuse, rand_write_reuse, rand_rw_reuse\n"
-		"  ptr_chase\n\n"
+		"  stride_read, stride_write, stride_rw\n"
+		"  gather8, gather64, scatter8, scatter64 (and *_scalar loops)\n"
+		"  rand_read_pf, rand_rw_pf (software prefetch)\n"
+		"  stream_copy, stream_scale, stream_add, stream_triad\n"
+		"  atomic_add_shared, atomic_cas_shared (one counter for all threads)\n"
+		"  atomic_add_packed, atomic_cas_packed (per-thread, 8 per line)\n"
+		"  atomic_add_padded, atomic_cas_padded (per-thread, own lines)\n"
+		"  c2c_pingpong (one line handed between threads 0 and 1, 2 and 3, ...)\n"
+		"  spsc_ring (producers 0, 2, ... to consumers 1, 3, ...)\n"
+		"  mpsc_ring (producers 1..N-1 to consumer 0)\n"
+		"  fill_store, fill_nt, fill_stosb, fill_memset\n"
+		"  copy_store, copy_nt, copy_movsb, copy_memcpy\n"
+		"  ptr_chase, ptr_chase_mlp, ptr_chase_pf, tlb_chase\n"
+		"  nop (harness overhead, no memory access)\n\n"
 		"Examples:\n"
 		"  %s --mode single --bench seq_read --size 64M --threads 4 --seconds 5\n"
 		"  %s --mode seq --benches seq_read,seq_write,rand_read --seconds 3\n"
-		"  %s --mode concurrent --benches seq_read,rand_rw --threads 2 --seconds 5\n",
-		prog, prog, prog, prog);
+		"  %s --mode concurrent --benches seq_read,rand_rw --threads 2 --seconds 5\n"
+		"  %s --mode mlp --size 1G --threads 1 --seconds 2\n"
+		"  %s --mode loaded-latency --bench seq_read --size 1G --threads 8 --pin core\n"
+		"  %s --mode size-sweep --bench ptr_chase --sizes 4K:1G --threads 1\n"
+		"  %s --mode scaling --bench seq_read --size 4G --thread-list 1-16 --pin core\n"
+		"  %s --mode width --benches seq_read,seq_write --threads 1 --pin core\n"
+		"  %s --mode tlb --size 256M --threads 1 --pin core\n"
+		"  %s --mode prefetch --size 1G --threads 1 --pin core --seconds 1\n"
+		"  %s --mode stores --sizes 4K:1G --threads 1 --pin core --seconds 0.5\n"
+		"  %s --mode c2c --cpus 0-15 --seconds 0.05 --format csv --output c2c.csv\n"
+		"  %s --mode queue --threads 4 --cpus 0-3 --seconds 0.5\n",
+		prog, prog, prog, prog, prog, prog, prog, prog, prog, prog, prog, prog,
+		prog, prog);
 }
 
 int cli_parse(int argc, char **argv, cli_args_t *args)
@@ -113,6 +488,32 @@ int cli_parse(int argc, char **argv, cli_args_t *args)
 		{ "reuse-iter",		required_argument, 0, 'I' },
 		{ "seed",			  required_argument, 0, 'S' },
 		{ "pin",			 required_argument, 0, 'p' },
+		{ "cpus",			  required_argument, 0, 'c' },
+		{ "share-cpus",	  no_argument,	   0, 'x' },
+		{ "numa",			  required_argument, 0, 'n' },
+		{ "pages",		   required_argument, 0, 'g' },
+		{ "chains",		   required_argument, 0, 'k' },
+		{ "lat-sample",	  required_argument, 0, 'L' },
+		{ "delays",		   required_argument, 0, 'D' },
+		{ "sizes",		   required_argument, 0, 'Z' },
+		{ "thread-list",	 required_argument, 0, 'N' },
+		{ "format",		   required_argument, 0, 'F' },
+		{ "output",		   required_argument, 0, 'o' },
+		{ "isa",			 required_argument, 0, 'A' },
+		{ "unroll",		   required_argument, 0, 'U' },
+		{ "index-stream",	  required_argument, 0, 'X' },
+		{ "gather-locality", required_argument, 0, 'G' },
+		{ "stride",		   required_argument, 0, 'Y' },
+		{ "direction",	   required_argument, 0, 'd' },
+		{ "perf",			  no_argument,	   0, 'E' },
+		{ "prefetch",		  required_argument, 0, 'H' },
+		{ "prefetch-dist",   required_argument, 0, 'J' },
+		{ "write-allocate",  no_argument,	   0, 'W' },
+		{ "atomic-delay",	  required_argument, 0, 'K' },
+		{ "msg-size",		  required_argument, 0, 'M' },
+		{ "rw-ratio",		  required_argument, 0, 'Q' },
+		{ "rw-other",		  no_argument,	   0, 'O' },
+		{ "ring-slots",	  required_argument, 0, 'r' },
 		{ "report-interval", required_argument, 0, 'P' },
 		{ "help",			  no_argument,	   0, 'h' },
 		{ 0,				 0,				 0, 0	 }
@@ -123,7 +524,7 @@ int cli_parse(int argc, char **argv, cli_args_t *args)
 
 	int opt;
 	int option_index = 0;
-	while ((opt = getopt_long(argc, argv, "m:b:B:s:t:T:i:R:I:S:p:P:h",
+	while ((opt = getopt_long(argc, argv, "m:b:B:s:t:T:i:R:I:S:p:c:xn:g:k:L:D:Z:N:F:o:A:U:X:G:Y:d:EH:J:WK:M:Q:Or:P:h",
 							  long_options, &option_index)) != -1) {
 		switch (opt) {
 		case 'm':
@@ -133,6 +534,26 @@ int cli_parse(int argc, char **argv, cli_args_t *args)
 				args->mode = MODE_SEQ;
 			} else if (strcmp(optarg, "concurrent") == 0) {
 				args->mode = MODE_CONCURRENT;
+			} else if (strcmp(optarg, "mlp") == 0) {
+				args->mode = MODE_MLP;
+			} else if (strcmp(optarg, "loaded-latency") == 0) {
+				args->mode = MODE_LOADED;
+			} else if (strcmp(optarg, "size-sweep") == 0) {
+				args->mode = MODE_SIZES;
+			} else if (strcmp(optarg, "scaling") == 0) {
+				args->mode = MODE_SCALING;
+			} else if (strcmp(optarg, "width") == 0) {
+				args->mode = MODE_WIDTH;
+			} else if (strcmp(optarg, "tlb") == 0) {
+				args->mode = MODE_TLB;
+			} else if (strcmp(optarg, "prefetch") == 0) {
+				args->mode = MODE_PREFETCH;
+			} else if (strcmp(optarg, "stores") == 0) {
+				args->mode = MODE_STORES;
+			} else if (strcmp(optarg, "c2c") == 0) {
+				args->mode = MODE_C2C;
+			} else if (strcmp(optarg, "queue") == 0) {
+				args->mode = MODE_QUEUE;
 			} else {
 				fprintf(stderr, "Unknown mode: %s\n", optarg);
 				return -1;
@@ -174,7 +595,253 @@ int cli_parse(int argc, char **argv, cli_args_t *args)
 			args->seed = (uint64_t)strtoull(optarg, NULL, 0);
 			break;
 		case 'p':
-			args->pin = atoi(optarg);
+			if (strcmp(optarg, "none") == 0 || strcmp(optarg, "0") == 0) {
+				args->pin = PIN_NONE;
+			} else if (strcmp(optarg, "compact") == 0 ||
+					   strcmp(optarg, "1") == 0) {
+				args->pin = PIN_COMPACT;
+			} else if (strcmp(optarg, "scatter") == 0) {
+				args->pin = PIN_SCATTER;
+			} else if (strcmp(optarg, "core") == 0) {
+				args->pin = PIN_CORE;
+			} else {
+				fprintf(stderr, "Unknown pin policy: %s\n", optarg);
+				return -1;
+			}
+			break;
+		case 'c':
+			args->cpu_count =
+				topo_parse_cpulist(optarg, args->cpu_list, MAX_CPUS);
+			if (args->cpu_count <= 0) {
+				fprintf(stderr, "Failed to parse CPU list: %s\n", optarg);
+				return -1;
+			}
+			args->pin = PIN_LIST;
+			break;
+		case 'x':
+			args->pin_share = 1;
+			break;
+		case 'n':
+			if (args->numa_count >= MAX_BENCHES ||
+				parse_numa_spec(optarg, &args->numa[args->numa_count]) < 0) {
+				fprintf(stderr, "Invalid NUMA policy: %s\n", optarg);
+				return -1;
+			}
+			args->numa_count++;
+			break;
+		case 'k':
+			args->chain_count =
+				parse_int_list(optarg, 1, args->chains, MAX_CHAINS);
+			if (args->chain_count <= 0) {
+				fprintf(stderr, "Failed to parse chain list: %s\n", optarg);
+				return -1;
+			}
+			for (int i = 0; i < args->chain_count; i++) {
+				if (args->chains[i] > MAX_CHAINS) {
+					fprintf(stderr, "Chain count must be 1-%d\n", MAX_CHAINS);
+					return -1;
+				}
+			}
+			break;
+		case 'D':
+			args->delay_count =
+				parse_int_list(optarg, 0, args->delays, MAX_DELAYS);
+			if (args->delay_count <= 0) {
+				fprintf(stderr, "Failed to parse delay list: %s\n", optarg);
+				return -1;
+			}
+			break;
+		case 'Z':
+			if (parse_size_range(optarg, args) < 0) {
+				fprintf(stderr, "Invalid size range: %s\n", optarg);
+				return -1;
+			}
+			break;
+		case 'N':
+			args->thread_list_count =
+				parse_int_list(optarg, 1, args->thread_list, MAX_THREAD_STEPS);
+			if (args->thread_list_count <= 0) {
+				fprintf(stderr, "Failed to parse thread list: %s\n", optarg);
+				return -1;
+			}
+			break;
+		case 'L':
+			args->lat_sample = (uint64_t)strtoull(optarg, NULL, 10);
+			if (args->lat_sample > 1) {
+				// Round up so the hot loops can test with a mask
+				uint64_t n = 1;
+				while (n < args->lat_sample)
+					n <<= 1;
+				args->lat_sample = n;
+			}
+			break;
+		case 'g':
+			if (strcmp(optarg, "4k") == 0 || strcmp(optarg, "4K") == 0) {
+				args->pages = PAGES_4K;
+			} else if (strcmp(optarg, "thp") == 0) {
+				args->pages = PAGES_THP;
+			} else if (strcmp(optarg, "hugetlb-2M") == 0 ||
+					   strcmp(optarg, "2M") == 0) {
+				args->pages = PAGES_HUGETLB_2M;
+			} else if (strcmp(optarg, "hugetlb-1G") == 0 ||
+					   strcmp(optarg, "1G") == 0) {
+				args->pages = PAGES_HUGETLB_1G;
+			} else if (strcmp(optarg, "auto") == 0) {
+				args->pages = PAGES_AUTO;
+			} else {
+				fprintf(stderr, "Unknown page mode: %s\n", optarg);
+				return -1;
+			}
+			break;
+		case 'F':
+			if (strcmp(optarg, "text") == 0) {
+				args->format = FORMAT_TEXT;
+			} else if (strcmp(optarg, "json") == 0) {
+				args->format = FORMAT_JSON;
+			} else if (strcmp(optarg, "csv") == 0) {
+				args->format = FORMAT_CSV;
+			} else {
+				fprintf(stderr, "Unknown format: %s\n", optarg);
+				return -1;
+			}
+			break;
+		case 'o':
+			strncpy(args->output, optarg, MAX_PATH - 1);
+			args->output[MAX_PATH - 1] = '\0';
+			break;
+		case 'A':
+			if (isa_parse(optarg, &args->isa) < 0) {
+				fprintf(stderr, "Unknown ISA: %s\n", optarg);
+				return -1;
+			}
+			break;
+		case 'U':
+			args->unroll_count =
+				parse_int_list(optarg, 1, args->unroll, MAX_UNROLL);
+			if (args->unroll_count <= 0) {
+				fprintf(stderr, "Failed to parse unroll list: %s\n", optarg);
+				return -1;
+			}
+			for (int i = 0; i < args->unroll_count; i++) {
+				int u = args->unroll[i];
+				if (u > MAX_UNROLL || (u & (u - 1))) {
+					fprintf(stderr, "Unroll must be 1, 2, 4 or 8\n");
+					return -1;
+				}
+			}
+			break;
+		case 'X':
+			args->index_stream = parse_size(optarg);
+			if (args->index_stream > 0) {
+				// Whole generator steps, wrapped with a mask
+				uint64_t n = 8;
+				while (n < args->index_stream)
+					n <<= 1;
+				args->index_stream = n;
+			}
+			break;
+		case 'G':
+			if (strcmp(optarg, "line") == 0) {
+				args->gather_span = 64;
+			} else if (strcmp(optarg, "page") == 0) {
+				args->gather_span = 4096;
+			} else if (strcmp(optarg, "random") == 0) {
+				args->gather_span = 0;
+			} else {
+				fprintf(stderr, "Unknown gather locality: %s\n", optarg);
+				return -1;
+			}
+			break;
+		case 'Y':
+			args->stride = parse_size(optarg);
+			if (args->stride == 0 || args->stride % 8) {
+				fprintf(stderr, "Stride must be a positive multiple of 8\n");
+				return -1;
+			}
+			break;
+		case 'd':
+			if (strcmp(optarg, "forward") == 0) {
+				args->backward = 0;
+			} else if (strcmp(optarg, "backward") == 0) {
+				args->backward = 1;
+			} else {
+				fprintf(stderr, "Unknown direction: %s\n", optarg);
+				return -1;
+			}
+			break;
+		case 'E':
+			args->perf = 1;
+			break;
+		case 'W':
+			args->write_allocate = 1;
+			break;
+		case 'K': {
+			long v = atol(optarg);
+			if (v < 0 || v > 1000000) {
+				fprintf(stderr, "Atomic delay must be 0-1000000 cycles\n");
+				return -1;
+			}
+			args->atomic_delay = (uint32_t)v;
+			break;
+		}
+		case 'M':
+			args->msg_size_count =
+				parse_size_list(optarg, args->msg_size, MAX_MSG_SIZES);
+			if (args->msg_size_count <= 0) {
+				fprintf(stderr, "Failed to parse message sizes: %s\n", optarg);
+				return -1;
+			}
+			for (int i = 0; i < args->msg_size_count; i++) {
+				if (args->msg_size[i] < 8 || args->msg_size[i] % 8 ||
+					args->msg_size[i] > MAX_MSG_SIZE) {
+					fprintf(stderr,
+							"Message size must be a multiple of 8 from 8 to %d\n",
+							MAX_MSG_SIZE);
+					return -1;
+				}
+			}
+			break;
+		case 'Q':
+			if (parse_rw_ratio(optarg, args) < 0) {
+				fprintf(stderr, "Read:write ratio must be R:W, each 0-%d: %s\n",
+						MAX_RW_RATIO, optarg);
+				return -1;
+			}
+			break;
+		case 'O':
+			args->rw_other = 1;
+			break;
+		case 'r': {
+			long v = atol(optarg);
+			if (v < 2 || v > MAX_RING_SLOTS || (v & (v - 1))) {
+				fprintf(stderr, "Ring slots must be a power of 2, 2-%d\n",
+						MAX_RING_SLOTS);
+				return -1;
+			}
+			args->ring_slots = (uint32_t)v;
+			break;
+		}
+		case 'H':
+			if (parse_prefetch_list(optarg, args) < 0) {
+				fprintf(stderr, "Failed to parse prefetch hints: %s\n", optarg);
+				return -1;
+			}
+			break;
+		case 'J':
+			args->prefetch_dist_count = parse_int_list(
+				optarg, 1, args->prefetch_dist, MAX_PREFETCH_DISTS);
+			if (args->prefetch_dist_count <= 0) {
+				fprintf(stderr, "Failed to parse prefetch distances: %s\n",
+						optarg);
+				return -1;
+			}
+			for (int i = 0; i < args->prefetch_dist_count; i++) {
+				if (args->prefetch_dist[i] > MAX_PREFETCH_DIST) {
+					fprintf(stderr, "Prefetch distance must be 1-%d\n",
+							MAX_PREFETCH_DIST);
+					return -1;
+				}
+			}
 			break;
 		case 'P':
 			args->report_interval = atof(optarg);
@@ -203,6 +870,15 @@ int cli_parse(int argc, char **argv, cli_args_t *args)
 		fprintf(stderr, "Error: --bench required for single mode\n");
 		return -1;
 	}
+	if (args->mode == MODE_SCALING && args->bench_name[0] == '\0') {
+		fprintf(stderr, "Error: --bench required for scaling mode\n");
+		return -1;
+	}
+	if (args->mode == MODE_SIZES && args->bench_name[0] == '\0' &&
+		args->bench_count == 0) {
+		fprintf(stderr, "Error: --bench or --benches required for size-sweep\n");
+		return -1;
+	}
 	if ((args->mode == MODE_SEQ || args->mode == MODE_CONCURRENT) &&
 		args->bench_count == 0) {
 		fprintf(stderr, "Error: --benches required for seq/concurrent mode\n");
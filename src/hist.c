@@ -0,0 +1,76 @@
+#include <string.h>
+#include "hist.h"
+
+// Smallest value that falls in bucket idx, and the bucket's width
+static void bucket_range(int idx, uint64_t *lo, uint64_t *width)
+{
+	if (idx < HIST_LINEAR) {
+		*lo	   = (uint64_t)idx;
+		*width = 1;
+		return;
+	}
+
+	int rel	  = idx - HIST_LINEAR;
+	int shift = rel / HIST_HALF + 1;
+	int top	  = rel % HIST_HALF + HIST_HALF;
+	*lo		  = (uint64_t)top << shift;
+	*width	  = 1ULL << shift;
+}
+
+void hist_clear(lat_hist_t *h)
+{
+	memset(h, 0, sizeof(*h));
+}
+
+void hist_merge(lat_hist_t *dst, const lat_hist_t *src)
+{
+	for (int i = 0; i < HIST_BUCKETS; i++) {
+		dst->buckets[i] += src->buckets[i];
+	}
+	dst->count += src->count;
+	if (src->max > dst->max)
+		dst->max = src->max;
+}
+
+void hist_delta(lat_hist_t *dst, const lat_hist_t *a, const lat_hist_t *b)
+{
+	int top = -1;
+	for (int i = 0; i < HIST_BUCKETS; i++) {
+		dst->buckets[i] = a->buckets[i] - b->buckets[i];
+		if (dst->buckets[i])
+			top = i;
+	}
+	dst->count = a->count - b->count;
+
+	// The exact interval max is gone; use the top of its highest bucket
+	dst->max = 0;
+	if (top >= 0) {
+		uint64_t lo, width;
+		bucket_range(top, &lo, &width);
+		dst->max = lo + width - 1 < a->max ? lo + width - 1 : a->max;
+	}
+}
+
+uint64_t hist_percentile(const lat_hist_t *h, double q)
+{
+	if (h->count == 0)
+		return 0;
+
+	uint64_t target = (uint64_t)(q * (double)h->count + 0.5);
+	if (target == 0)
+		target = 1;
+	if (target > h->count)
+		target = h->count;
+
+	uint64_t seen = 0;
+	for (int i = 0; i < HIST_BUCKETS; i++) {
+		seen += h->buckets[i];
+		if (seen >= target) {
+			uint64_t lo, width;
+			bucket_range(i, &lo, &width);
+			uint64_t mid = lo + width / 2;
+			return mid < h->max ? mid : h->max;
+		}
+	}
+	return h->max;
+}
@@ -0,0 +1,65 @@
+#include <string.h>
+#include <cpuid.h>
+#include "isa.h"
+
+// XCR0 bits the OS sets when it saves the register state on context switch
+#define XCR0_SSE	  (1u << 1)
+#define XCR0_AVX	  (1u << 2)
+#define XCR0_AVX512	  (7u << 5) // opmask, upper ZMM0-15, ZMM16-31
+
+static const char *const isa_names[ISA_COUNT] = { "scalar", "sse2", "avx2",
+												  "avx512" };
+
+static uint64_t xgetbv0(void)
+{
+	uint32_t lo, hi;
+	__asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+	return ((uint64_t)hi << 32) | lo;
+}
+
+isa_t isa_detect(void)
+{
+	unsigned int eax, ebx, ecx, edx;
+
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+		return ISA_SCALAR;
+
+	isa_t best = (edx & bit_SSE2) ? ISA_SSE2 : ISA_SCALAR;
+
+	// Wider registers are only usable if the OS saves them
+	if (!(ecx & bit_OSXSAVE) || !(ecx & bit_AVX))
+		return best;
+	uint64_t xcr0 = xgetbv0();
+	if ((xcr0 & (XCR0_SSE | XCR0_AVX)) != (XCR0_SSE | XCR0_AVX))
+		return best;
+
+	if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+		return best;
+	if (ebx & bit_AVX2)
+		best = ISA_AVX2;
+	if ((ebx & bit_AVX512F) && (xcr0 & XCR0_AVX512) == XCR0_AVX512)
+		best = ISA_AVX512;
+	return best;
+}
+
+int isa_parse(const char *name, isa_t *out)
+{
+	if (strcmp(name, "auto") == 0) {
+		*out = ISA_AUTO;
+		return 0;
+	}
+	for (int i = 0; i < ISA_COUNT; i++) {
+		if (strcmp(name, isa_names[i]) == 0) {
+			*out = (isa_t)i;
+			return 0;
+		}
+	}
+	return -1;
+}
+
+const char *isa_name(isa_t isa)
+{
+	if (isa < 0 || isa >= ISA_COUNT)
+		return "auto";
+	return isa_names[isa];
+}
@@ -2,7 +2,10 @@
 #include <stdlib.h>
 #include "cli.h"
 #include "runner.h"
+#include "sweep.h"
 #include "bench.h"
+#include "report.h"
+#include "isa.h"
 
 int main(int argc, char **argv)
 {
@@ -13,6 +16,15 @@ int main(int argc, char **argv)
 		return 1;
 	}
 
+	if (bench_set_isa(args.isa) < 0)
+		return 1;
+
+	if (report_open(&args) < 0)
+		return 1;
+
+	printf("Kernel ISA: %s (%s)\n", isa_name(bench_isa()),
+		   args.isa == ISA_AUTO ? "auto" : "--isa");
+
 	int ret = 0;
 
 	switch (args.mode) {
@@ -25,10 +37,41 @@ int main(int argc, char **argv)
 	case MODE_CONCURRENT:
 		ret = run_concurrent(&args);
 		break;
+	case MODE_MLP:
+		ret = run_mlp(&args);
+		break;
+	case MODE_LOADED:
+		ret = run_loaded_latency(&args);
+		break;
+	case MODE_SIZES:
+		ret = run_size_sweep(&args);
+		break;
+	case MODE_SCALING:
+		ret = run_scaling(&args);
+		break;
+	case MODE_WIDTH:
+		ret = run_width(&args);
+		break;
+	case MODE_TLB:
+		ret = run_tlb(&args);
+		break;
+	case MODE_PREFETCH:
+		ret = run_prefetch(&args);
+		break;
+	case MODE_STORES:
+		ret = run_stores(&args);
+		break;
+	case MODE_C2C:
+		ret = run_c2c(&args);
+		break;
+	case MODE_QUEUE:
+		ret = run_queue(&args);
+		break;
 	default:
 		fprintf(stderr, "Unknown mode\n");
 		ret = 1;
 	}
 
+	report_close();
 	return ret;
 }
@@ -1,9 +1,30 @@
 #define _GNU_SOURCE
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
 #include "memory.h"
 
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#define MEM_MAP_HUGE_2MB (21 << MAP_HUGE_SHIFT)
+#define MEM_MAP_HUGE_1GB (30 << MAP_HUGE_SHIFT)
+
+#define SIZE_2M ((size_t)2 << 20)
+#define SIZE_1G ((size_t)1 << 30)
+
+// Memory policy modes from <linux/mempolicy.h>
+#define MEM_MPOL_PREFERRED			  1
+#define MEM_MPOL_BIND				  2
+#define MEM_MPOL_INTERLEAVE			  3
+#define MEM_MPOL_PREFERRED_MANY		  5
+#define MEM_MPOL_WEIGHTED_INTERLEAVE 6
+
 void *mem_alloc_aligned(size_t size, size_t alignment)
 {
 	void *ptr = NULL;
@@ -18,6 +39,241 @@ void mem_free_aligned(void *ptr)
 	free(ptr);
 }
 
+size_t mem_page_size(page_mode_t mode)
+{
+	switch (mode) {
+	case PAGES_THP:
+	case PAGES_HUGETLB_2M:
+		return SIZE_2M;
+	case PAGES_HUGETLB_1G:
+		return SIZE_1G;
+	default:
+		return 4096;
+	}
+}
+
+// Mapping length for a buffer: whole pages of the mode's page size
+static size_t map_length(size_t size, page_mode_t mode)
+{
+	size_t page = mem_page_size(mode);
+	return (size + page - 1) & ~(page - 1);
+}
+
+static void *map_hugetlb(size_t size, int huge_flag)
+{
+	void *ptr = mmap(NULL, size, PROT_READ | PROT_WRITE,
+					 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | huge_flag, -1,
+					 0);
+	return ptr == MAP_FAILED ? NULL : ptr;
+}
+
+// Map 2 MB aligned memory and ask for transparent huge pages
+static void *map_thp(size_t size)
+{
+	size_t len = size + SIZE_2M;
+	char  *raw = mmap(NULL, len, PROT_READ | PROT_WRITE,
+					  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (raw == MAP_FAILED)
+		return NULL;
+
+	// Trim to a 2 MB aligned start so every huge page can be used
+	uintptr_t addr	= ((uintptr_t)raw + SIZE_2M - 1) & ~(SIZE_2M - 1);
+	char	 *ptr	= (char *)addr;
+	size_t	  head	= (size_t)(ptr - raw);
+	size_t	  tail	= len - head - size;
+	if (head)
+		munmap(raw, head);
+	if (tail)
+		munmap(ptr + size, tail);
+
+	if (madvise(ptr, size, MADV_HUGEPAGE) != 0) {
+		munmap(ptr, size);
+		return NULL;
+	}
+	return ptr;
+}
+
+static void *map_4k(size_t size)
+{
+	void *ptr = mmap(NULL, size, PROT_READ | PROT_WRITE,
+					 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (ptr == MAP_FAILED)
+		return NULL;
+
+	// Keep THP "always" from silently promoting the buffer
+	madvise(ptr, size, MADV_NOHUGEPAGE);
+	return ptr;
+}
+
+void *mem_alloc_pages(size_t size, page_mode_t mode, page_mode_t *actual)
+{
+	void *ptr = NULL;
+
+	switch (mode) {
+	case PAGES_4K:
+		ptr = map_4k(map_length(size, mode));
+		break;
+	case PAGES_THP:
+		ptr = map_thp(map_length(size, mode));
+		break;
+	case PAGES_HUGETLB_2M:
+		ptr = map_hugetlb(map_length(size, mode), MEM_MAP_HUGE_2MB);
+		break;
+	case PAGES_HUGETLB_1G:
+		ptr = map_hugetlb(map_length(size, mode), MEM_MAP_HUGE_1GB);
+		break;
+	case PAGES_AUTO: {
+		// hugetlb mmap fails up front when too few pages are reserved
+		static const page_mode_t order[] = { PAGES_HUGETLB_1G, PAGES_HUGETLB_2M,
+											 PAGES_THP, PAGES_4K };
+		for (size_t i = 0; i < sizeof(order) / sizeof(order[0]); i++) {
+			// 1 GB pages only pay off when the buffer fills most of one
+			if (order[i] == PAGES_HUGETLB_1G && size < SIZE_1G)
+				continue;
+			ptr = mem_alloc_pages(size, order[i], actual);
+			if (ptr)
+				return ptr;
+		}
+		return NULL;
+	}
+	}
+
+	if (ptr && actual)
+		*actual = mode;
+	return ptr;
+}
+
+void mem_free_pages(void *ptr, size_t size, page_mode_t mode)
+{
+	munmap(ptr, map_length(size, mode));
+}
+
+int mem_page_info(void *ptr, size_t size, mem_page_info_t *info)
+{
+	memset(info, 0, sizeof(*info));
+
+	FILE *f = fopen("/proc/self/smaps", "r");
+	if (!f)
+		return -1;
+
+	uintptr_t addr	 = (uintptr_t)ptr;
+	int		  inside = 0, found = 0;
+	char	  line[256];
+	size_t	  hugetlb = 0;
+
+	while (fgets(line, sizeof(line), f)) {
+		unsigned long lo, hi;
+		size_t		  kb;
+
+		// Mapping header lines look like "start-end perms ..."
+		if (sscanf(line, "%lx-%lx ", &lo, &hi) == 2) {
+			if (inside)
+				break;
+			inside = addr >= lo && addr < hi;
+			found |= inside;
+			continue;
+		}
+		if (!inside)
+			continue;
+
+		if (sscanf(line, "KernelPageSize: %zu kB", &kb) == 1) {
+			info->kernel_page_size = kb * 1024;
+		} else if (sscanf(line, "Rss: %zu kB", &kb) == 1) {
+			info->rss_bytes += kb * 1024;
+		} else if (sscanf(line, "AnonHugePages: %zu kB", &kb) == 1) {
+			info->huge_bytes += kb * 1024;
+		} else if (sscanf(line, "Private_Hugetlb: %zu kB", &kb) == 1 ||
+				   sscanf(line, "Shared_Hugetlb: %zu kB", &kb) == 1) {
+			hugetlb += kb * 1024;
+		}
+	}
+	fclose(f);
+
+	if (!found)
+		return -1;
+
+	// hugetlb memory is not counted in Rss
+	info->rss_bytes += hugetlb;
+	info->huge_bytes += hugetlb;
+	info->huge_page_size =
+		hugetlb ? info->kernel_page_size : (info->huge_bytes ? SIZE_2M : 0);
+
+	// A merged mapping may extend past the buffer
+	if (info->rss_bytes > size)
+		info->rss_bytes = size;
+	if (info->huge_bytes > size)
+		info->huge_bytes = size;
+	return 0;
+}
+
+int mem_set_numa_policy(void *ptr, size_t size, numa_policy_t policy,
+						uint64_t nodes)
+{
+	int mode;
+
+	switch (policy) {
+	case NUMA_LOCAL:
+		// Default policy: pages land where they are first touched
+		return 0;
+	case NUMA_BIND:
+		mode = MEM_MPOL_BIND;
+		break;
+	case NUMA_INTERLEAVE:
+		mode = MEM_MPOL_INTERLEAVE;
+		break;
+	case NUMA_PREFERRED:
+		mode = __builtin_popcountll(nodes) > 1 ? MEM_MPOL_PREFERRED_MANY :
+												 MEM_MPOL_PREFERRED;
+		break;
+	case NUMA_WEIGHTED:
+		mode = MEM_MPOL_WEIGHTED_INTERLEAVE;
+		break;
+	default:
+		return -1;
+	}
+
+	unsigned long mask = (unsigned long)nodes;
+	if (syscall(SYS_mbind, ptr, size, mode, &mask, MAX_NUMA_NODES + 1, 0) ==
+		0)
+		return 0;
+
+	// Weighted interleave needs Linux 6.9; plain interleave is closest
+	if (policy == NUMA_WEIGHTED && errno == EINVAL) {
+		fprintf(stderr, "Warning: weighted interleave unsupported by kernel, "
+						"using interleave\n");
+		if (syscall(SYS_mbind, ptr, size, MEM_MPOL_INTERLEAVE, &mask,
+					MAX_NUMA_NODES + 1, 0) == 0)
+			return 0;
+	}
+
+	perror("mbind");
+	return -1;
+}
+
+int mem_query_nodes(void **pages, int *status, size_t count)
+{
+	// move_pages with no target nodes only reports current placement
+	if (syscall(SYS_move_pages, 0, count, pages, NULL, status, 0) != 0)
+		return -1;
+	return 0;
+}
+
+int mem_interleave_weight(int node)
+{
+	char path[128];
+	snprintf(path, sizeof(path),
+			 "/sys/kernel/mm/mempolicy/weighted_interleave/node%d", node);
+
+	FILE *f = fopen(path, "r");
+	if (!f)
+		return 0;
+	int weight = 0;
+	if (fscanf(f, "%d", &weight) != 1)
+		weight = 0;
+	fclose(f);
+	return weight;
+}
+
 void mem_touch_pages(void *ptr, size_t size)
 {
 	volatile char *p		 = (volatile char *)ptr;
@@ -35,11 +291,19 @@ void mem_zero(void *ptr, size_t size)
 
 void mem_fill_pattern(void *ptr, size_t size, uint64_t seed)
 {
-	uint64_t *p		= (uint64_t *)ptr;
-	size_t	  count = size / sizeof(uint64_t);
+	mem_fill_pattern_range(ptr, 0, size, seed);
+}
+
+void mem_fill_pattern_range(void *base, size_t offset, size_t size,
+							uint64_t seed)
+{
+	uint64_t *p		= (uint64_t *)base;
+	size_t	  i		= offset / sizeof(uint64_t);
+	size_t	  end	= (offset + size) / sizeof(uint64_t);
 
-	// Simple pattern fill
-	for (size_t i = 0; i < count; i++) {
+	// Reference version for the baseline target; workload setup uses the
+	// per-ISA bench_fill_pattern, which writes the same words
+	for (; i < end; i++) {
 		p[i] = seed ^ (uint64_t)i;
 	}
 }
@@ -0,0 +1,171 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <stdatomic.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "perf.h"
+
+// Generic cache event config: cache id, operation, result
+#define CACHE_EVENT(cache, op, result)                           \
+	((uint64_t)(cache) | ((uint64_t)(op) << 8) | ((uint64_t)(result) << 16))
+
+typedef struct {
+	const char *name;
+	uint32_t	type;
+	uint64_t	config;
+} perf_spec_t;
+
+// Generic events, so the kernel maps them to each CPU's own encoding
+static const perf_spec_t specs[PERF_EVENT_COUNT] = {
+	{ "cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+	{ "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+	{ "llc_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+	{ "l1d_repl", PERF_TYPE_HW_CACHE,
+	  CACHE_EVENT(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ,
+				  PERF_COUNT_HW_CACHE_RESULT_MISS) },
+	{ "dtlb_misses", PERF_TYPE_HW_CACHE,
+	  CACHE_EVENT(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ,
+				  PERF_COUNT_HW_CACHE_RESULT_MISS) },
+	{ "node_reads", PERF_TYPE_HW_CACHE,
+	  CACHE_EVENT(PERF_COUNT_HW_CACHE_NODE, PERF_COUNT_HW_CACHE_OP_READ,
+				  PERF_COUNT_HW_CACHE_RESULT_ACCESS) },
+};
+
+// Missing events are reported by the first worker to find them missing;
+// bit PERF_EVENT_COUNT stands for a group that never ran, the next bit for
+// the fallback to one group per event
+#define REPORT_NEVER_RAN (1u << PERF_EVENT_COUNT)
+#define REPORT_SPLIT	 (1u << (PERF_EVENT_COUNT + 1))
+static atomic_uint reported;
+
+const char *perf_event_name(perf_event_t event)
+{
+	return event >= 0 && event < PERF_EVENT_COUNT ? specs[event].name :
+													"unknown";
+}
+
+// Open every available event, all in one group or each as its own leader
+static void perf_open_events(perf_group_t *g, int grouped)
+{
+	g->nleader = 0;
+	g->count   = 0;
+
+	for (int i = 0; i < PERF_EVENT_COUNT; i++) {
+		int leader = grouped && g->nleader ? g->leader[0] : -1;
+
+		struct perf_event_attr attr;
+		memset(&attr, 0, sizeof(attr));
+		attr.size			= sizeof(attr);
+		attr.type			= specs[i].type;
+		attr.config			= specs[i].config;
+		attr.disabled		= leader < 0; // members follow the leader
+		attr.exclude_kernel = 1;
+		attr.exclude_hv		= 1;
+		attr.read_format	= PERF_FORMAT_GROUP |
+							   PERF_FORMAT_TOTAL_TIME_ENABLED |
+							   PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+		int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0);
+		g->fd[i] = fd;
+		if (fd < 0) {
+			int err = errno;
+			if (!(atomic_fetch_or(&reported, 1u << i) & (1u << i)))
+				fprintf(stderr, "[perf] %s unavailable: %s\n", specs[i].name,
+						strerror(err));
+			continue;
+		}
+		if (leader < 0)
+			g->leader[g->nleader++] = fd;
+		g->order[g->count++] = i;
+	}
+}
+
+// Whether the group gets on the PMU at all: a group that does not fit is
+// never scheduled, so a short enabled spell shows no running time
+static int perf_group_runs(const perf_group_t *g)
+{
+	uint64_t buf[3 + PERF_EVENT_COUNT];
+
+	ioctl(g->leader[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	for (volatile int spin = 0; spin < 100000; spin++)
+		;
+	ioctl(g->leader[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+	ssize_t len = read(g->leader[0], buf, sizeof(buf));
+	return len >= (ssize_t)(3 * sizeof(uint64_t)) && buf[2] > 0;
+}
+
+int perf_open(perf_group_t *g)
+{
+	perf_open_events(g, 1);
+	if (g->count < 2 || perf_group_runs(g))
+		return g->count;
+
+	// E.g. six events on four general counters, with the NMI watchdog
+	// holding the fixed cycles counter: count each on its own instead
+	if (!(atomic_fetch_or(&reported, REPORT_SPLIT) & REPORT_SPLIT))
+		fprintf(stderr, "[perf] events do not fit one group: counting them "
+						"separately, multiplexed\n");
+	perf_close(g);
+	perf_open_events(g, 0);
+	return g->count;
+}
+
+void perf_start(perf_group_t *g)
+{
+	for (int j = 0; j < g->nleader; j++) {
+		ioctl(g->leader[j], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+		ioctl(g->leader[j], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	}
+}
+
+unsigned perf_stop(perf_group_t *g, uint64_t *counts)
+{
+	memset(counts, 0, PERF_EVENT_COUNT * sizeof(uint64_t));
+	for (int j = 0; j < g->nleader; j++)
+		ioctl(g->leader[j], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+	// Groups hold consecutive events of g->order
+	unsigned valid = 0;
+	int		 pos   = 0;
+	for (int j = 0; j < g->nleader; j++) {
+		// nr, time_enabled, time_running, then one value per member
+		uint64_t buf[3 + PERF_EVENT_COUNT];
+		ssize_t	 len = read(g->leader[j], buf, sizeof(buf));
+		if (len < (ssize_t)(3 * sizeof(uint64_t)))
+			break;
+		uint64_t nr = buf[0];
+		if (buf[2] == 0) {
+			// Never scheduled, e.g. counters taken by another user
+			if (!(atomic_fetch_or(&reported, REPORT_NEVER_RAN) &
+				  REPORT_NEVER_RAN))
+				fprintf(stderr, "[perf] counter group never ran: not counted\n");
+			pos += (int)nr;
+			continue;
+		}
+
+		// A group is scheduled as a whole, so one ratio scales its members
+		double scale = (double)buf[1] / (double)buf[2];
+		for (uint64_t k = 0; k < nr && pos < g->count; k++, pos++) {
+			int i	  = g->order[pos];
+			counts[i] = (uint64_t)((double)buf[3 + k] * scale);
+			valid |= 1u << i;
+		}
+	}
+	return valid;
+}
+
+void perf_close(perf_group_t *g)
+{
+	for (int i = 0; i < PERF_EVENT_COUNT; i++) {
+		if (g->fd[i] >= 0)
+			close(g->fd[i]);
+		g->fd[i] = -1;
+	}
+	g->nleader = 0;
+	g->count   = 0;
+}
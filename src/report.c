@@ -0,0 +1,331 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/utsname.h>
+#include "report.h"
+#include "topology.h"
+#include "tsc.h"
+#include "isa.h"
+#include "bench.h"
+
+#define REPORT_LINE		 8192
+#define REPORT_MAX_TYPES 8
+
+static FILE			   *report_out;
+static output_format_t	report_fmt = FORMAT_TEXT;
+static pthread_mutex_t	report_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Record being built: JSON object, or CSV header and value rows
+static char	  rec_type[32];
+static char	  rec_keys[REPORT_LINE];
+static char	  rec_vals[REPORT_LINE];
+static size_t rec_keys_len;
+static size_t rec_vals_len;
+
+// CSV: last header written per record type, to repeat it only on change
+static char csv_types[REPORT_MAX_TYPES][32];
+static char csv_headers[REPORT_MAX_TYPES][REPORT_LINE];
+static int	csv_type_count;
+
+static void append(char *buf, size_t *len, const char *fmt, ...)
+	__attribute__((format(printf, 3, 4)));
+
+static void append(char *buf, size_t *len, const char *fmt, ...)
+{
+	if (*len >= REPORT_LINE)
+		return;
+
+	va_list ap;
+	va_start(ap, fmt);
+	int n = vsnprintf(buf + *len, REPORT_LINE - *len, fmt, ap);
+	va_end(ap);
+	if (n > 0)
+		*len += (size_t)n;
+}
+
+// Quote a value for the current format into out
+static void quote(const char *val, char *out, size_t len)
+{
+	size_t n = 0;
+
+	if (report_fmt == FORMAT_CSV && !strpbrk(val, ",\"\n")) {
+		snprintf(out, len, "%s", val);
+		return;
+	}
+
+	out[n++] = '"';
+	for (const char *p = val; *p; p++) {
+		unsigned char c = (unsigned char)*p;
+		char		  esc[8];
+		size_t		  m = 1;
+
+		esc[0] = (char)c;
+		if (c == '"') {
+			// JSON escapes with a backslash, CSV doubles the quote
+			esc[0] = report_fmt == FORMAT_JSON ? '\\' : '"';
+			esc[1] = '"';
+			m	   = 2;
+		} else if (report_fmt == FORMAT_JSON && c == '\\') {
+			esc[1] = '\\';
+			m	   = 2;
+		} else if (report_fmt == FORMAT_JSON && c < 0x20) {
+			// Short escapes where JSON has one, \u00XX for the rest
+			char named = c == '\b' ? 'b' : c == '\f' ? 'f' : c == '\n' ? 'n' :
+						 c == '\r' ? 'r' : c == '\t' ? 't' : 0;
+			if (named) {
+				esc[0] = '\\';
+				esc[1] = named;
+				m	   = 2;
+			} else {
+				m = (size_t)snprintf(esc, sizeof(esc), "\\u%04x", c);
+			}
+		}
+
+		// Room for the escape, the closing quote and the NUL
+		if (n + m + 2 > len)
+			break;
+		memcpy(&out[n], esc, m);
+		n += m;
+	}
+	out[n++] = '"';
+	out[n]	 = '\0';
+}
+
+// Add a field whose value is already formatted (raw = no quoting needed)
+static void add_field(const char *key, const char *val, int raw)
+{
+	char quoted[1024];
+	if (!raw) {
+		quote(val, quoted, sizeof(quoted));
+		val = quoted;
+	}
+
+	if (report_fmt == FORMAT_JSON) {
+		append(rec_vals, &rec_vals_len, ",\"%s\":%s", key, val);
+	} else {
+		append(rec_keys, &rec_keys_len, ",%s", key);
+		append(rec_vals, &rec_vals_len, ",%s", val);
+	}
+}
+
+void report_begin(const char *type)
+{
+	if (report_fmt == FORMAT_TEXT)
+		return;
+
+	pthread_mutex_lock(&report_lock);
+	snprintf(rec_type, sizeof(rec_type), "%s", type);
+	rec_keys_len = 0;
+	rec_vals_len = 0;
+	if (report_fmt == FORMAT_JSON) {
+		append(rec_vals, &rec_vals_len, "{\"type\":\"%s\"", type);
+	} else {
+		append(rec_keys, &rec_keys_len, "type");
+		append(rec_vals, &rec_vals_len, "%s", type);
+	}
+}
+
+void report_str(const char *key, const char *val)
+{
+	if (report_fmt == FORMAT_TEXT)
+		return;
+	add_field(key, val, 0);
+}
+
+void report_u64(const char *key, uint64_t val)
+{
+	if (report_fmt == FORMAT_TEXT)
+		return;
+
+	char buf[32];
+	snprintf(buf, sizeof(buf), "%lu", val);
+	add_field(key, buf, 1);
+}
+
+void report_f(const char *key, double val, int prec)
+{
+	if (report_fmt == FORMAT_TEXT)
+		return;
+
+	char buf[64];
+	if (isnan(val) || isinf(val))
+		snprintf(buf, sizeof(buf), "%s", report_fmt == FORMAT_JSON ? "null" : "");
+	else
+		snprintf(buf, sizeof(buf), "%.*f", prec, val);
+	add_field(key, buf, 1);
+}
+
+void report_end(void)
+{
+	if (report_fmt == FORMAT_TEXT)
+		return;
+
+	if (report_fmt == FORMAT_JSON) {
+		fprintf(report_out, "%s}\n", rec_vals);
+	} else {
+		// The type is the first column, so a header covers the rows of its
+		// type that follow
+		int i = 0;
+		while (i < csv_type_count && strcmp(csv_types[i], rec_type) != 0)
+			i++;
+		if (i == csv_type_count && i < REPORT_MAX_TYPES) {
+			snprintf(csv_types[i], sizeof(csv_types[i]), "%s", rec_type);
+			csv_headers[i][0] = '\0';
+			csv_type_count++;
+		}
+		if (i == REPORT_MAX_TYPES || strcmp(csv_headers[i], rec_keys) != 0) {
+			if (i < REPORT_MAX_TYPES)
+				snprintf(csv_headers[i], REPORT_LINE, "%s", rec_keys);
+			fprintf(report_out, "%s\n", rec_keys);
+		}
+		fprintf(report_out, "%s\n", rec_vals);
+	}
+	fflush(report_out);
+	pthread_mutex_unlock(&report_lock);
+}
+
+output_format_t report_format(void)
+{
+	return report_fmt;
+}
+
+// First "model name" in /proc/cpuinfo
+static void cpu_model(char *buf, size_t len)
+{
+	char  line[512];
+	FILE *f = fopen("/proc/cpuinfo", "r");
+
+	snprintf(buf, len, "unknown");
+	if (!f)
+		return;
+	while (fgets(line, sizeof(line), f)) {
+		if (strncmp(line, "model name", 10) != 0)
+			continue;
+		const char *colon = strchr(line, ':');
+		if (colon) {
+			colon += strspn(colon + 1, " \t") + 1;
+			snprintf(buf, len, "%.*s", (int)strcspn(colon, "\n"), colon);
+		}
+		break;
+	}
+	fclose(f);
+}
+
+static void report_host(void)
+{
+	char		   host[256] = "unknown";
+	char		   model[256];
+	char		   stamp[64];
+	struct utsname uts;
+	time_t		   now = time(NULL);
+	struct tm	   tm;
+
+	gethostname(host, sizeof(host) - 1);
+	host[sizeof(host) - 1] = '\0';
+	cpu_model(model, sizeof(model));
+	gmtime_r(&now, &tm);
+	strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%SZ", &tm);
+	if (uname(&uts) < 0)
+		memset(&uts, 0, sizeof(uts));
+
+	report_begin("host");
+	report_str("time", stamp);
+	report_str("hostname", host);
+	report_str("kernel", uts.release);
+	report_str("arch", uts.machine);
+	report_str("cpu_model", model);
+	report_u64("cpus_online", (uint64_t)sysconf(_SC_NPROCESSORS_ONLN));
+	report_f("tsc_ghz", tsc_ghz(), 3);
+	report_str("isa_max", isa_name(isa_detect()));
+	report_end();
+}
+
+static void report_config(const cli_args_t *args)
+{
+	char benches[MAX_BENCHES * MAX_BENCH_NAME] = "";
+	if (args->bench_count) {
+		size_t len = 0;
+		for (int i = 0; i < args->bench_count; i++) {
+			append(benches, &len, "%s%s", i ? "," : "", args->bench_list[i]);
+		}
+	} else {
+		snprintf(benches, sizeof(benches), "%s", args->bench_name);
+	}
+
+	// 0:0 is the default 1:1 read-modify-write
+	int	 mixed = args->rw_read + args->rw_write != 0;
+	char rw_ratio[32];
+	snprintf(rw_ratio, sizeof(rw_ratio), "%u:%u", mixed ? args->rw_read : 1,
+			 mixed ? args->rw_write : 1);
+
+	report_begin("config");
+	report_str("mode", cli_mode_name(args->mode));
+	report_str("bench", benches);
+	report_u64("size", args->buffer_size);
+	report_u64("threads", (uint64_t)args->threads);
+	report_str("stop", args->stop_mode == STOP_TIME ? "time" : "iters");
+	report_f("seconds", args->seconds, 3);
+	report_u64("iters", args->iters);
+	report_str("pin", topo_policy_name(args->pin));
+	report_str("pages", cli_page_mode_name(args->pages));
+	report_str("numa", cli_numa_policy_name(cli_numa_spec(args, 0)->policy));
+	report_u64("seed", args->seed);
+	report_u64("lat_sample", args->lat_sample);
+	report_str("isa", isa_name(bench_isa()));
+	report_u64("perf", (uint64_t)args->perf);
+	report_u64("write_allocate", (uint64_t)args->write_allocate);
+	report_str("rw_ratio", rw_ratio);
+	report_u64("rw_other", (uint64_t)args->rw_other);
+	report_f("report_interval", args->report_interval, 3);
+	report_end();
+}
+
+int report_open(const cli_args_t *args)
+{
+	report_fmt = args->format;
+
+	if (report_fmt == FORMAT_TEXT) {
+		// Everything is the report; send it all to the file
+		if (args->output[0] && !freopen(args->output, "w", stdout)) {
+			perror(args->output);
+			return -1;
+		}
+		return 0;
+	}
+
+	if (args->output[0]) {
+		report_out = fopen(args->output, "w");
+		if (!report_out) {
+			perror(args->output);
+			return -1;
+		}
+	} else {
+		// Records keep stdout to themselves; everything else goes to stderr
+		fflush(stdout);
+		int fd = dup(STDOUT_FILENO);
+		if (fd < 0 || !(report_out = fdopen(fd, "w"))) {
+			perror("stdout");
+			return -1;
+		}
+		dup2(STDERR_FILENO, STDOUT_FILENO);
+	}
+
+	report_host();
+	report_config(args);
+	return 0;
+}
+
+void report_close(void)
+{
+	if (report_out) {
+		fclose(report_out);
+		report_out = NULL;
+	}
+	fflush(stdout);
+}
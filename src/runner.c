@@ -4,39 +4,127 @@
 #include <string.h>
 #include <pthread.h>
 #include <sched.h>
+#include <errno.h>
+#include <time.h>
 #include "runner.h"
 #include "memory.h"
 #include "bench.h"
+#include "tsc.h"
+#include "perf.h"
+
+// Free everything workload_init allocated (all pointers may be NULL)
+static void workload_release(workload_ctx_t *wctx)
+{
+	for (int k = 1; k < wctx->narrays; k++) {
+		if (wctx->arrays[k])
+			mem_free_pages(wctx->arrays[k], wctx->buffer_size, wctx->pages);
+		wctx->arrays[k] = NULL;
+	}
+	if (wctx->buffer) {
+		mem_free_pages(wctx->buffer, wctx->buffer_size, wctx->pages);
+		wctx->buffer	= NULL;
+		wctx->arrays[0] = NULL;
+	}
+	if (wctx->threads) {
+		free(wctx->threads);
+		wctx->threads = NULL;
+	}
+	if (wctx->worker_ctxs) {
+		for (int i = 0; i < wctx->args->threads; i++) {
+			free(wctx->worker_ctxs[i].priv);
+		}
+		free(wctx->worker_ctxs);
+		wctx->worker_ctxs = NULL;
+	}
+	if (wctx->cpus) {
+		free(wctx->cpus);
+		wctx->cpus = NULL;
+	}
+
+	stats_destroy(&wctx->stats);
+}
+
+// Per-thread iteration budget; time-based runs have none
+static uint64_t workload_iters(const cli_args_t *args, int threads)
+{
+	if (args->stop_mode != STOP_ITERS)
+		return UINT64_MAX;
+	return args->iters / (uint64_t)threads; // Divide iters among threads
+}
 
 int workload_init(workload_ctx_t *wctx, const bench_desc_t *bench,
-				  cli_args_t *args)
+				  cli_args_t *args, const topo_t *topo,
+				  unsigned char *cpu_used, const numa_spec_t *numa)
 {
 	memset(wctx, 0, sizeof(*wctx));
-	wctx->bench = bench;
-	wctx->args	= args;
+	wctx->bench		  = bench;
+	wctx->args		  = args;
+	wctx->topo		  = topo;
+	wctx->numa		  = *numa;
+	wctx->buffer_size = args->buffer_size;
+	wctx->active	  = args->threads;
 
 	// Initialize stats
 	if (stats_init(&wctx->stats, bench->name, args->threads) < 0) {
 		return -1;
 	}
 
-	// Allocate buffer (64-byte aligned)
-	wctx->buffer = mem_alloc_aligned(args->buffer_size, 64);
+	// Allocate buffer (page-aligned mapping so a NUMA policy can apply)
+	wctx->buffer = mem_alloc_pages(wctx->buffer_size, args->pages, &wctx->pages);
 	if (!wctx->buffer) {
+		if (args->pages == PAGES_HUGETLB_2M || args->pages == PAGES_HUGETLB_1G) {
+			fprintf(stderr,
+					"Failed to map %s buffer; are enough hugetlb pages "
+					"reserved (/sys/kernel/mm/hugepages)?\n",
+					cli_page_mode_name(args->pages));
+		}
 		stats_destroy(&wctx->stats);
 		return -1;
 	}
 
-	// Touch pages and fill with pattern
-	mem_touch_pages(wctx->buffer, args->buffer_size);
-	mem_fill_pattern(wctx->buffer, args->buffer_size, args->seed);
+	// Further arrays are mapped separately, the way independently allocated
+	// arrays would be, with the backing the first one got
+	wctx->arrays[0] = wctx->buffer;
+	wctx->narrays	= bench->arrays > 1 ? bench->arrays : 1;
+	for (int k = 1; k < wctx->narrays; k++) {
+		wctx->arrays[k] = mem_alloc_pages(wctx->buffer_size, wctx->pages, NULL);
+		if (!wctx->arrays[k]) {
+			fprintf(stderr, "Failed to map array %d of %d\n", k + 1,
+					wctx->narrays);
+			workload_release(wctx);
+			return -1;
+		}
+	}
+
+	// Policy must be in place before the first touch in workload_start
+	if (wctx->numa.policy != NUMA_LOCAL && wctx->numa.nodes == 0) {
+		wctx->numa.nodes = topo->mem_nodes ? topo->mem_nodes : 1;
+	}
+	for (int k = 0; k < wctx->narrays; k++) {
+		if (mem_set_numa_policy(wctx->arrays[k], wctx->buffer_size,
+								wctx->numa.policy, wctx->numa.nodes) < 0) {
+			fprintf(stderr, "Failed to apply NUMA policy %s\n",
+					cli_numa_policy_name(wctx->numa.policy));
+			workload_release(wctx);
+			return -1;
+		}
+	}
 
 	// Allocate thread structures
 	wctx->threads	  = calloc((size_t)args->threads, sizeof(pthread_t));
 	wctx->worker_ctxs = calloc((size_t)args->threads, sizeof(worker_ctx_t));
-	if (!wctx->threads || !wctx->worker_ctxs) {
-		mem_free_aligned(wctx->buffer);
-		stats_destroy(&wctx->stats);
+	wctx->cpus		  = calloc((size_t)args->threads, sizeof(int));
+	if (!wctx->threads || !wctx->worker_ctxs || !wctx->cpus) {
+		workload_release(wctx);
+		return -1;
+	}
+
+	// Place threads on CPUs
+	if (topo_place(topo, args->pin, args->cpu_list, args->cpu_count,
+				   args->threads, cpu_used, wctx->cpus) < 0) {
+		fprintf(stderr, "Failed to place threads (pin=%s)\n",
+				topo_policy_name(args->pin));
+		workload_release(wctx);
 		return -1;
 	}
 
@@ -46,26 +134,47 @@ int workload_init(workload_ctx_t *wctx, const bench_desc_t *bench,
 	atomic_store(&wctx->stop_flag, 0);
 
 	// Setup worker contexts
-	// Round chunk_size down to 64-byte boundary for AVX-512 alignment
+	// Round chunk_size down to a 64-byte boundary for aligned line access
 	size_t chunk_size = (args->buffer_size / (size_t)args->threads) &
 						~(size_t)63;
+	wctx->chunk_size = chunk_size;
 	for (int i = 0; i < args->threads; i++) {
 		worker_ctx_t *w = &wctx->worker_ctxs[i];
 		w->thread_id	= i;
 		w->thread_count = args->threads;
+		w->cpu			= wctx->cpus[i];
 		w->buffer		= (char *)wctx->buffer + (size_t)i * chunk_size;
 		w->buffer_size	= chunk_size;
+		for (int k = 0; k < wctx->narrays; k++)
+			w->array[k] = (char *)wctx->arrays[k] + (size_t)i * chunk_size;
+		w->write_allocate = args->write_allocate;
+		w->rw_read		  = args->rw_read;
+		w->rw_write		  = args->rw_write;
+		w->rw_other		  = args->rw_other;
+		w->shared		  = wctx->buffer;
+		w->atomic_delay	  = args->atomic_delay;
+		w->msg_size		  = args->msg_size_count ? (uint32_t)args->msg_size[0] : 64;
+		w->ring_slots	  = args->ring_slots;
 		w->reuse_mode	= bench->reuse_mode;
 		w->region_bytes = args->region_bytes;
 		w->reuse_iter	= args->reuse_iter;
+		w->chains		= args->chain_count ? args->chains[0] : 8;
+		w->unroll		= args->unroll_count ? args->unroll[0] : 1;
+		w->index_stream = args->index_stream;
+		w->gather_span	= args->gather_span;
+		w->prefetch		 = args->prefetch_count ? args->prefetch[0] : PREFETCH_T0;
+		w->prefetch_dist = args->prefetch_dist_count ?
+							   (uint32_t)args->prefetch_dist[0] :
+							   0;
+		w->stride		= args->stride;
+		w->backward		= args->backward;
 		w->stop_flag	= &wctx->stop_flag;
 		w->stop_mode	= args->stop_mode;
 		w->max_seconds	= args->seconds;
-		w->max_iters	= args->iters / (uint64_t)args->threads; // Divide iters
-															  // among threads
+		w->max_iters	= workload_iters(args, args->threads);
 		w->stats	  = &wctx->stats.thread_stats[i];
+		w->lat_mask	  = args->lat_sample ? args->lat_sample - 1 : UINT64_MAX;
 		w->barrier	  = &wctx->barrier;
-		w->start_time = &wctx->start_time;
 
 		// Initialize PRNG with unique seed per thread
 		prng_init(&w->prng, args->seed + (uint64_t)i * 0x9E3779B97F4A7C15UL);
@@ -74,11 +183,24 @@ int workload_init(workload_ctx_t *wctx, const bench_desc_t *bench,
 	return 0;
 }
 
+// Fill the part of each array owned by one worker. The fill is the first
+// touch, so running it on the worker makes placement follow the worker's CPU.
+static void workload_setup_chunk(workload_ctx_t *wctx, int thread_id)
+{
+	int	   last	 = thread_id == wctx->args->threads - 1;
+	size_t start = (size_t)thread_id * wctx->chunk_size;
+	size_t end	 = last ? wctx->buffer_size : start + wctx->chunk_size;
+
+	for (int k = 0; k < wctx->narrays; k++)
+		bench_fill_pattern(wctx->arrays[k], start, end - start,
+						   wctx->args->seed);
+}
+
 // Thread entry point that calls the benchmark function
 typedef struct {
+	workload_ctx_t	  *wctx;
 	worker_ctx_t	  *ctx;
 	bench_func_t	   func;
-	struct timespec	  *shared_start;
 	pthread_barrier_t *barrier;
 } thread_entry_t;
 
@@ -87,46 +209,133 @@ static void *thread_entry(void *arg)
 	thread_entry_t *entry = (thread_entry_t *)arg;
 	worker_ctx_t   *ctx	  = entry->ctx;
 
-	// Wait at barrier
+	// Setup phase: initialize our own chunk before anyone starts measuring.
+	// Later runs of the same workload reuse it.
+	if (!entry->wctx->prepared)
+		workload_setup_chunk(entry->wctx, ctx->thread_id);
+	if (!entry->wctx->inited && entry->wctx->bench->init)
+		entry->wctx->bench->init(ctx);
+	if (entry->wctx->setup_only)
+		return NULL;
+
+	// Counters are opened before the barrier and run only around the
+	// kernel, so setup never shows up in them
+	perf_group_t perf;
+	int			 use_perf = entry->wctx->args->perf;
+	if (use_perf)
+		perf_open(&perf);
+
+	// Start together; the coordinator takes the start time
 	pthread_barrier_wait(entry->barrier);
 
-	// First thread records start time
-	if (ctx->thread_id == 0) {
-		clock_gettime(CLOCK_MONOTONIC, entry->shared_start);
+	// Run benchmark; the kernel may stop the counters early
+	ctx->perf = use_perf ? &perf : NULL;
+	if (use_perf)
+		perf_start(&perf);
+	entry->func(ctx);
+	if (use_perf) {
+		bench_measure_end(ctx);
+		perf_close(&perf);
 	}
+	if (entry->wctx->probe_clock)
+		ctx->core_ghz = tsc_core_ghz();
 
-	// Small barrier again to ensure start time is set
-	pthread_barrier_wait(entry->barrier);
+	atomic_fetch_sub(&entry->wctx->running_workers, 1);
+	return NULL;
+}
 
-	// Run benchmark
-	entry->func(ctx);
+// Longest sleep between checks for an early stop
+#define COORD_SLICE_NS 10000000L
 
-	return NULL;
+// Runs on the thread that called workload_start while the workers measure.
+// It owns the clock: starts it when setup is done and raises stop_flag at the
+// deadline, so kernels only poll the flag. Iteration budgets are checked by
+// the workers themselves and need no deadline.
+static void workload_coordinate(workload_ctx_t *wctx)
+{
+	pthread_barrier_wait(&wctx->barrier);
+	clock_gettime(CLOCK_MONOTONIC, &wctx->start_time);
+	stats_set_setup(&wctx->stats, &wctx->setup_start, &wctx->start_time);
+	stats_start(&wctx->stats, &wctx->start_time);
+
+	const worker_ctx_t *w = &wctx->worker_ctxs[0];
+	if (w->stop_mode != STOP_TIME)
+		return;
+
+	double			whole	 = (double)(time_t)w->max_seconds;
+	struct timespec deadline = wctx->start_time;
+	deadline.tv_sec += (time_t)whole;
+	deadline.tv_nsec += (long)((w->max_seconds - whole) * 1e9);
+	if (deadline.tv_nsec >= 1000000000L) {
+		deadline.tv_sec++;
+		deadline.tv_nsec -= 1000000000L;
+	}
+
+	// Wake up now and then for workload_halt or workers that ran out early
+	while (!atomic_load(&wctx->stop_flag) &&
+		   atomic_load(&wctx->running_workers) > 0) {
+		struct timespec now, wake;
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		if (now.tv_sec > deadline.tv_sec ||
+			(now.tv_sec == deadline.tv_sec && now.tv_nsec >= deadline.tv_nsec))
+			break;
+
+		wake = now;
+		wake.tv_nsec += COORD_SLICE_NS;
+		if (wake.tv_nsec >= 1000000000L) {
+			wake.tv_sec++;
+			wake.tv_nsec -= 1000000000L;
+		}
+		if (wake.tv_sec > deadline.tv_sec ||
+			(wake.tv_sec == deadline.tv_sec && wake.tv_nsec > deadline.tv_nsec))
+			wake = deadline;
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL);
+	}
+	atomic_store(&wctx->stop_flag, 1);
 }
 
 int workload_start(workload_ctx_t *wctx)
 {
-	// Re-init barrier for 2 phases
+	// Workers plus the coordinator meet at the start
 	pthread_barrier_destroy(&wctx->barrier);
-	pthread_barrier_init(&wctx->barrier, NULL, (unsigned)wctx->args->threads);
+	pthread_barrier_init(&wctx->barrier, NULL, (unsigned)wctx->active + 1);
 
 	// Create thread entries
 	thread_entry_t *entries =
-		calloc((size_t)wctx->args->threads, sizeof(thread_entry_t));
+		calloc((size_t)wctx->active, sizeof(thread_entry_t));
 	if (!entries)
 		return -1;
 
-	// Start stats timing (shares start_time with workers)
-	stats_start(&wctx->stats, &wctx->start_time);
-
-	for (int i = 0; i < wctx->args->threads; i++) {
-		entries[i].ctx			= &wctx->worker_ctxs[i];
-		entries[i].func			= wctx->bench->func;
-		entries[i].shared_start = &wctx->start_time;
-		entries[i].barrier		= &wctx->barrier;
+	// Rerunning a workload starts from clean counters
+	atomic_store(&wctx->stop_flag, 0);
+	atomic_store(&wctx->running_workers, wctx->active);
+	stats_reset(&wctx->stats);
+
+	// Setup phase runs on the workers from here until the start barrier
+	clock_gettime(CLOCK_MONOTONIC, &wctx->setup_start);
+
+	for (int i = 0; i < wctx->active; i++) {
+		entries[i].wctx	   = wctx;
+		entries[i].ctx	   = &wctx->worker_ctxs[i];
+		entries[i].func	   = bench_kernel(wctx->bench);
+		entries[i].barrier = &wctx->barrier;
+
+		// Pin before the thread starts so it never runs elsewhere
+		pthread_attr_t attr;
+		pthread_attr_init(&attr);
+		if (wctx->cpus[i] >= 0) {
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			CPU_SET((size_t)wctx->cpus[i], &set);
+			pthread_attr_setaffinity_np(&attr, sizeof(set), &set);
+		}
 
-		if (pthread_create(&wctx->threads[i], NULL, thread_entry,
-						   &entries[i]) != 0) {
+		int rc = pthread_create(&wctx->threads[i], &attr, thread_entry,
+								&entries[i]);
+		pthread_attr_destroy(&attr);
+		if (rc != 0) {
+			fprintf(stderr, "Failed to start thread %d (cpu %d)\n", i,
+					wctx->cpus[i]);
 			// Cleanup on failure
 			atomic_store(&wctx->stop_flag, 1);
 			for (int j = 0; j < i; j++) {
@@ -137,15 +346,25 @@ int workload_start(workload_ctx_t *wctx)
 		}
 	}
 
-	// Store entries for later cleanup (hack: store in unused field or just free
-	// after join) We'll wait immediately after this, so it's okay
+	if (!wctx->setup_only)
+		workload_coordinate(wctx);
 
 	// Wait for all threads
-	for (int i = 0; i < wctx->args->threads; i++) {
+	for (int i = 0; i < wctx->active; i++) {
 		pthread_join(wctx->threads[i], NULL);
 	}
 
 	free(entries);
+	wctx->prepared = 1;
+	wctx->inited   = 1;
+
+	// A setup-only pass never started the clock
+	if (wctx->setup_only) {
+		struct timespec now;
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		stats_set_setup(&wctx->stats, &wctx->setup_start, &now);
+		return 0;
+	}
 
 	// Stop stats
 	stats_stop(&wctx->stats);
@@ -153,6 +372,56 @@ int workload_start(workload_ctx_t *wctx)
 	return 0;
 }
 
+int workload_prepare(workload_ctx_t *wctx)
+{
+	if (wctx->prepared)
+		return 0;
+
+	wctx->setup_only = 1;
+	int rc			 = workload_start(wctx);
+	wctx->setup_only = 0;
+	return rc;
+}
+
+int workload_resize(workload_ctx_t *wctx, size_t size)
+{
+	if (size > wctx->buffer_size)
+		return -1;
+
+	// Same rounding as workload_init, but never below one line
+	size_t per_thread = (size / (size_t)wctx->active) & ~(size_t)63;
+	if (per_thread < 64)
+		per_thread = 64;
+	if (per_thread > wctx->chunk_size)
+		per_thread = wctx->chunk_size;
+
+	for (int i = 0; i < wctx->active; i++) {
+		wctx->worker_ctxs[i].buffer_size = per_thread;
+	}
+	wctx->inited = 0;
+	return 0;
+}
+
+int workload_set_threads(workload_ctx_t *wctx, int active)
+{
+	if (active < 1 || active > wctx->args->threads || !wctx->prepared)
+		return -1;
+
+	size_t slice = (wctx->buffer_size / (size_t)active) & ~(size_t)63;
+	for (int i = 0; i < active; i++) {
+		worker_ctx_t *w = &wctx->worker_ctxs[i];
+		w->thread_count = active;
+		w->buffer		= (char *)wctx->buffer + (size_t)i * slice;
+		w->buffer_size	= slice;
+		for (int k = 0; k < wctx->narrays; k++)
+			w->array[k] = (char *)wctx->arrays[k] + (size_t)i * slice;
+		w->max_iters	= workload_iters(wctx->args, active);
+	}
+	wctx->active = active;
+	wctx->inited = 0;
+	return 0;
+}
+
 void workload_wait(workload_ctx_t *wctx)
 {
 	// Already waited in workload_start
@@ -161,21 +430,133 @@ void workload_wait(workload_ctx_t *wctx)
 void workload_destroy(workload_ctx_t *wctx)
 {
 	pthread_barrier_destroy(&wctx->barrier);
+	workload_release(wctx);
+}
 
-	if (wctx->buffer) {
-		mem_free_aligned(wctx->buffer);
-		wctx->buffer = NULL;
+int runner_topo_init(cli_args_t *args, topo_t *topo)
+{
+	if (topo_discover(topo) == 0) {
+		if (args->pin != PIN_NONE)
+			topo_print(topo);
+		return 0;
 	}
-	if (wctx->threads) {
-		free(wctx->threads);
-		wctx->threads = NULL;
+	if (args->pin != PIN_NONE) {
+		fprintf(stderr, "CPU topology unavailable, cannot pin\n");
+		return -1;
 	}
-	if (wctx->worker_ctxs) {
-		free(wctx->worker_ctxs);
-		wctx->worker_ctxs = NULL;
+	return 0;
+}
+
+void workload_print_placement(workload_ctx_t *wctx)
+{
+	if (wctx->args->pin == PIN_NONE)
+		return;
+
+	printf("[%s] Pinning: %s cpus=", wctx->bench->name,
+		   topo_policy_name(wctx->args->pin));
+	for (int i = 0; i < wctx->args->threads; i++) {
+		printf("%s%d", i ? "," : "", wctx->cpus[i]);
 	}
+	printf("\n");
+}
 
-	stats_destroy(&wctx->stats);
+// Describe the NUMA placement of a workload, e.g. "interleave:0,1"
+static void format_numa(workload_ctx_t *wctx, char *buf, size_t len)
+{
+	int n = snprintf(buf, len, "%s", cli_numa_policy_name(wctx->numa.policy));
+	int first = 1;
+
+	for (int node = 0; node < MAX_NUMA_NODES && (size_t)n < len; node++) {
+		if (!(wctx->numa.nodes & (1ULL << node)))
+			continue;
+		n += snprintf(buf + n, len - (size_t)n, "%c%d", first ? ':' : ',',
+					  node);
+		first = 0;
+	}
+
+	if (wctx->numa.policy != NUMA_WEIGHTED)
+		return;
+	first = 1;
+	for (int node = 0; node < MAX_NUMA_NODES && (size_t)n < len; node++) {
+		if (!(wctx->numa.nodes & (1ULL << node)))
+			continue;
+		n += snprintf(buf + n, len - (size_t)n, "%s%d=%d",
+					  first ? " weights=" : ",", node,
+					  mem_interleave_weight(node));
+		first = 0;
+	}
+}
+
+// Report where the buffer's pages actually landed, sampled with move_pages.
+// "local" is the share of pages on the node of the pinned thread using them.
+static void print_buffer_placement(workload_ctx_t *wctx)
+{
+	const size_t page	 = 4096;
+	size_t		 npages	 = wctx->buffer_size / page;
+	size_t		 samples = npages < 4096 ? npages : 4096;
+	if (samples == 0)
+		return;
+
+	void **pages  = malloc(samples * sizeof(void *));
+	int	  *status = malloc(samples * sizeof(int));
+	if (!pages || !status) {
+		free(pages);
+		free(status);
+		return;
+	}
+
+	for (size_t i = 0; i < samples; i++) {
+		pages[i] = (char *)wctx->buffer + (i * npages / samples) * page;
+	}
+
+	if (mem_query_nodes(pages, status, samples) < 0) {
+		free(pages);
+		free(status);
+		return;
+	}
+
+	size_t node_pages[MAX_NUMA_NODES] = { 0 };
+	size_t resident = 0, local = 0;
+	for (size_t i = 0; i < samples; i++) {
+		if (status[i] < 0 || status[i] >= MAX_NUMA_NODES)
+			continue;
+		node_pages[status[i]]++;
+		resident++;
+
+		size_t off = (size_t)((char *)pages[i] - (char *)wctx->buffer);
+		int	   tid = wctx->chunk_size ? (int)(off / wctx->chunk_size) : 0;
+		if (tid >= wctx->args->threads)
+			tid = wctx->args->threads - 1;
+		const topo_cpu_t *cpu = topo_find(wctx->topo, wctx->cpus[tid]);
+		if (cpu && cpu->node == status[i])
+			local++;
+	}
+
+	mem_page_info_t pinfo;
+	if (mem_page_info(wctx->buffer, wctx->buffer_size, &pinfo) == 0) {
+		printf("[%s] Page backing: %s huge_pages=%zu (%.1f MB of %.1f MB "
+			   "resident)\n",
+			   wctx->bench->name, cli_page_mode_name(wctx->pages),
+			   pinfo.huge_page_size ? pinfo.huge_bytes / pinfo.huge_page_size :
+									  0,
+			   (double)pinfo.huge_bytes / (1024.0 * 1024.0),
+			   (double)pinfo.rss_bytes / (1024.0 * 1024.0));
+	}
+
+	printf("[%s] Buffer placement:", wctx->bench->name);
+	for (int node = 0; node < MAX_NUMA_NODES; node++) {
+		if (node_pages[node] && resident) {
+			printf(" node%d=%.1f%%", node,
+				   100.0 * (double)node_pages[node] / (double)resident);
+		}
+	}
+	if (wctx->args->pin != PIN_NONE && resident) {
+		printf(" local=%.1f%%", 100.0 * (double)local / (double)resident);
+	}
+	printf("\n");
+
+	free(pages);
+	free(status);
 }
 
 // Run single workload
@@ -187,6 +568,10 @@ int run_single(cli_args_t *args)
 		return -1;
 	}
 
+	topo_t topo;
+	if (runner_topo_init(args, &topo) < 0)
+		return -1;
+
 	printf("Running benchmark: %s\n", bench->name);
 	printf("Buffer size: %zu bytes, Threads: %d\n", args->buffer_size,
 		   args->threads);
@@ -198,13 +583,19 @@ int run_single(cli_args_t *args)
 	printf("\n");
 
 	workload_ctx_t wctx;
-	if (workload_init(&wctx, bench, args) < 0) {
+	if (workload_init(&wctx, bench, args, &topo, NULL,
+					  cli_numa_spec(args, 0)) < 0) {
 		fprintf(stderr, "Failed to initialize workload\n");
+		topo_destroy(&topo);
 		return -1;
 	}
 
-	printf("Buffer info: start=%p, size=%zu bytes\n", wctx.buffer,
-		   args->buffer_size);
+	char numa_desc[256];
+	format_numa(&wctx, numa_desc, sizeof(numa_desc));
+	printf("Buffer info: start=%p, size=%zu bytes, numa=%s, pages=%s\n",
+		   wctx.buffer, args->buffer_size, numa_desc,
+		   cli_page_mode_name(wctx.pages));
+	workload_print_placement(&wctx);
 
 	// Start reporter
 	atomic_int	   reporter_stop_flag = ATOMIC_VAR_INIT(0);
@@ -221,15 +612,21 @@ int run_single(cli_args_t *args)
 	reporter_stop(&reporter);
 
 	// Print final stats
+	print_buffer_placement(&wctx);
 	stats_print_final(&wctx.stats);
 
 	workload_destroy(&wctx);
+	topo_destroy(&topo);
 	return 0;
 }
 
 // Run sequential workload list
 int run_sequential(cli_args_t *args)
 {
+	topo_t topo;
+	if (runner_topo_init(args, &topo) < 0)
+		return -1;
+
 	printf("Running %d benchmarks sequentially\n\n", args->bench_count);
 
 	for (int i = 0; i < args->bench_count; i++) {
@@ -247,13 +644,18 @@ int run_sequential(cli_args_t *args)
 
 		workload_ctx_t wctx;
 		// Run workload
-		if (workload_init(&wctx, bench, args) < 0) {
+		if (workload_init(&wctx, bench, args, &topo, NULL,
+						  cli_numa_spec(args, i)) < 0) {
 			fprintf(stderr, "Failed to initialize workload: %s\n", bench->name);
 			continue;
 		}
 
-		printf("Buffer info: start=%p, size=%zu bytes\n", wctx.buffer,
-			   args->buffer_size);
+		char numa_desc[256];
+		format_numa(&wctx, numa_desc, sizeof(numa_desc));
+		printf("Buffer info: start=%p, size=%zu bytes, numa=%s, pages=%s\n",
+			   wctx.buffer, args->buffer_size, numa_desc,
+			   cli_page_mode_name(wctx.pages));
+		workload_print_placement(&wctx);
 
 		// Start reporter
 		atomic_int	   reporter_stop_flag = ATOMIC_VAR_INIT(0);
@@ -270,21 +672,18 @@ int run_sequential(cli_args_t *args)
 		reporter_stop(&reporter);
 
 		// Print final stats
+		print_buffer_placement(&wctx);
 		stats_print_final(&wctx.stats);
 
 		workload_destroy(&wctx);
 		printf("\n");
 	}
 
+	topo_destroy(&topo);
 	return 0;
 }
 
 // Concurrent mode worker thread
-typedef struct {
-	workload_ctx_t	  *wctx;
-	pthread_barrier_t *global_barrier;
-} concurrent_workload_t;
-
 static void *concurrent_workload_thread(void *arg)
 {
 	concurrent_workload_t *cw	= (concurrent_workload_t *)arg;
@@ -299,29 +698,63 @@ static void *concurrent_workload_thread(void *arg)
 	return NULL;
 }
 
+int workload_launch(concurrent_workload_t *cw)
+{
+	if (pthread_create(&cw->thread, NULL, concurrent_workload_thread, cw) !=
+		0) {
+		fprintf(stderr, "Failed to start workload thread: %s\n",
+				cw->wctx->bench->name);
+		return -1;
+	}
+	return 0;
+}
+
+void workload_halt(concurrent_workload_t *cw)
+{
+	// workload_start clears stop_flag on entry, so keep raising it until
+	// the thread is gone in case it had not got that far yet
+	struct timespec tick = { 0, 1000000 };
+	for (;;) {
+		atomic_store(&cw->wctx->stop_flag, 1);
+		if (pthread_tryjoin_np(cw->thread, NULL) != EBUSY)
+			break;
+		nanosleep(&tick, NULL);
+	}
+}
+
 // Run concurrent workload list
 int run_concurrent(cli_args_t *args)
 {
+	topo_t topo;
+	if (runner_topo_init(args, &topo) < 0)
+		return -1;
+
 	printf("Running %d benchmarks concurrently\n", args->bench_count);
 	int total_threads = args->bench_count * args->threads;
 	printf("Total threads: %d (warning if > CPU cores)\n\n", total_threads);
 
+	// Keep workloads on disjoint CPUs unless sharing was requested
+	unsigned char *cpu_used = NULL;
+	if (args->pin != PIN_NONE && !args->pin_share) {
+		cpu_used = calloc(MAX_CPUS, 1);
+	}
+
 	// Initialize all workloads
 	workload_ctx_t *wctxs =
 		calloc((size_t)args->bench_count, sizeof(workload_ctx_t));
 	stats_ctx_t **stats_arr =
 		calloc((size_t)args->bench_count, sizeof(stats_ctx_t *));
-	pthread_t *workload_threads =
-		calloc((size_t)args->bench_count, sizeof(pthread_t));
 	concurrent_workload_t *cws =
 		calloc((size_t)args->bench_count, sizeof(concurrent_workload_t));
 
-	if (!wctxs || !stats_arr || !workload_threads || !cws) {
+	if (!wctxs || !stats_arr || !cws ||
+		(args->pin != PIN_NONE && !args->pin_share && !cpu_used)) {
 		fprintf(stderr, "Memory allocation failed\n");
 		free(wctxs);
 		free(stats_arr);
-		free(workload_threads);
 		free(cws);
+		free(cpu_used);
+		topo_destroy(&topo);
 		return -1;
 	}
 
@@ -336,7 +769,8 @@ int run_concurrent(cli_args_t *args)
 			continue;
 		}
 
-		if (workload_init(&wctxs[active_count], bench, args) < 0) {
+		if (workload_init(&wctxs[active_count], bench, args, &topo,
+						  cpu_used, cli_numa_spec(args, i)) < 0) {
 			fprintf(stderr, "Failed to initialize workload: %s\n", bench->name);
 			continue;
 		}
@@ -345,8 +779,13 @@ int run_concurrent(cli_args_t *args)
 		cws[active_count].global_barrier = &global_barrier;
 		stats_arr[active_count]			 = &wctxs[active_count].stats;
 
-		printf("[%s] Buffer info: start=%p, size=%zu bytes\n", bench->name,
-			   wctxs[active_count].buffer, args->buffer_size);
+		char numa_desc[256];
+		format_numa(&wctxs[active_count], numa_desc, sizeof(numa_desc));
+		printf("[%s] Buffer info: start=%p, size=%zu bytes, numa=%s, "
+			   "pages=%s\n",
+			   bench->name, wctxs[active_count].buffer, args->buffer_size,
+			   numa_desc, cli_page_mode_name(wctxs[active_count].pages));
+		workload_print_placement(&wctxs[active_count]);
 
 		active_count++;
 	}
@@ -356,8 +795,9 @@ int run_concurrent(cli_args_t *args)
 		pthread_barrier_destroy(&global_barrier);
 		free(wctxs);
 		free(stats_arr);
-		free(workload_threads);
 		free(cws);
+		free(cpu_used);
+		topo_destroy(&topo);
 		return -1;
 	}
 
@@ -365,6 +805,16 @@ int run_concurrent(cli_args_t *args)
 	pthread_barrier_destroy(&global_barrier);
 	pthread_barrier_init(&global_barrier, NULL, (unsigned)active_count);
 
+	// Finish every workload's setup (buffer fill, init hook) first, so no
+	// workload measures alone while another is still setting up. The run
+	// restarts the stats, so keep each workload's setup time aside.
+	double *setup_sec = calloc((size_t)active_count, sizeof(double));
+	for (int i = 0; i < active_count; i++) {
+		workload_prepare(&wctxs[i]);
+		if (setup_sec)
+			setup_sec[i] = wctxs[i].stats.setup_sec;
+	}
+
 	// Start reporter
 	atomic_int	   reporter_stop_flag = ATOMIC_VAR_INIT(0);
 	reporter_ctx_t reporter;
@@ -374,13 +824,12 @@ int run_concurrent(cli_args_t *args)
 	// Launch all workload threads
 	for (int i = 0; i < active_count; i++) {
 		cws[i].global_barrier = &global_barrier;
-		pthread_create(&workload_threads[i], NULL, concurrent_workload_thread,
-					   &cws[i]);
+		workload_launch(&cws[i]);
 	}
 
 	// Wait for all to complete
 	for (int i = 0; i < active_count; i++) {
-		pthread_join(workload_threads[i], NULL);
+		pthread_join(cws[i].thread, NULL);
 	}
 
 	// Stop reporter
@@ -390,15 +839,20 @@ int run_concurrent(cli_args_t *args)
 	// Print final stats for each
 	printf("\n=== Concurrent Results ===\n");
 	for (int i = 0; i < active_count; i++) {
+		if (setup_sec)
+			wctxs[i].stats.setup_sec = setup_sec[i];
+		print_buffer_placement(&wctxs[i]);
 		stats_print_final(&wctxs[i].stats);
 		workload_destroy(&wctxs[i]);
 	}
 
 	pthread_barrier_destroy(&global_barrier);
+	free(setup_sec);
 	free(wctxs);
 	free(stats_arr);
-	free(workload_threads);
 	free(cws);
+	free(cpu_used);
+	topo_destroy(&topo);
 
 	return 0;
 }
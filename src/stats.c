@@ -1,8 +1,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 #include <unistd.h>
 #include "stats.h"
+#include "report.h"
+#include "tsc.h"
 
 int stats_init(stats_ctx_t *ctx, const char *bench_name, int thread_count)
 {
@@ -17,6 +20,26 @@ int stats_init(stats_ctx_t *ctx, const char *bench_name, int thread_count)
 	}
 	memset(ctx->thread_stats, 0, (size_t)thread_count * sizeof(thread_stats_t));
 
+	// One histogram per thread plus three for merging, each on its own lines
+	ctx->thread_hists = aligned_alloc(
+		CACHE_LINE_SIZE, (size_t)(thread_count + 3) * sizeof(lat_hist_t));
+	if (!ctx->thread_hists) {
+		free(ctx->thread_stats);
+		ctx->thread_stats = NULL;
+		return -1;
+	}
+	memset(ctx->thread_hists, 0,
+		   (size_t)(thread_count + 3) * sizeof(lat_hist_t));
+	for (int i = 0; i < thread_count; i++) {
+		ctx->thread_stats[i].hist = &ctx->thread_hists[i];
+	}
+	ctx->lat_total	  = &ctx->thread_hists[thread_count];
+	ctx->lat_last	  = &ctx->thread_hists[thread_count + 1];
+	ctx->lat_interval = &ctx->thread_hists[thread_count + 2];
+
+	// Calibrate now rather than during the first report
+	tsc_ghz();
+
 	atomic_store(&ctx->running, 0);
 	atomic_store(&ctx->done, 0);
 
@@ -29,6 +52,41 @@ void stats_destroy(stats_ctx_t *ctx)
 		free(ctx->thread_stats);
 		ctx->thread_stats = NULL;
 	}
+	if (ctx->thread_hists) {
+		free(ctx->thread_hists);
+		ctx->thread_hists = NULL;
+	}
+}
+
+void stats_reset(stats_ctx_t *ctx)
+{
+	for (int i = 0; i < ctx->thread_count; i++) {
+		ctx->thread_stats[i].ops	  = 0;
+		ctx->thread_stats[i].bytes_rd = 0;
+		ctx->thread_stats[i].bytes_wr = 0;
+		ctx->thread_stats[i].checksum = 0;
+		ctx->thread_stats[i].idx_cycles = 0;
+		ctx->thread_stats[i].idx_ops	= 0;
+		ctx->thread_stats[i].lines		= 0;
+		ctx->thread_stats[i].perf_valid = 0;
+		memset(ctx->thread_stats[i].perf, 0, sizeof(ctx->thread_stats[i].perf));
+	}
+	memset(ctx->thread_hists, 0,
+		   (size_t)(ctx->thread_count + 3) * sizeof(lat_hist_t));
+	ctx->last_ops		= 0;
+	ctx->last_bytes_rd	= 0;
+	ctx->last_bytes_wr	= 0;
+	ctx->total_ops		= 0;
+	ctx->total_bytes_rd = 0;
+	ctx->total_bytes_wr = 0;
+	ctx->total_checksum = 0;
+	ctx->total_idx_cycles = 0;
+	ctx->total_idx_ops	  = 0;
+	ctx->total_lines	  = 0;
+	ctx->perf_valid		  = 0;
+	memset(ctx->total_perf, 0, sizeof(ctx->total_perf));
+	ctx->elapsed_sec	= 0;
+	ctx->setup_sec		= 0;
 }
 
 void stats_start(stats_ctx_t *ctx, struct timespec *start_time)
@@ -37,6 +95,13 @@ void stats_start(stats_ctx_t *ctx, struct timespec *start_time)
 	atomic_store(&ctx->running, 1);
 }
 
+void stats_set_setup(stats_ctx_t *ctx, const struct timespec *setup_start,
+					 const struct timespec *start_time)
+{
+	ctx->setup_sec = (double)(start_time->tv_sec - setup_start->tv_sec) +
+					 (double)(start_time->tv_nsec - setup_start->tv_nsec) / 1e9;
+}
+
 double stats_elapsed(stats_ctx_t *ctx)
 {
 	struct timespec now;
@@ -50,18 +115,65 @@ double stats_elapsed(stats_ctx_t *ctx)
 void stats_aggregate(stats_ctx_t *ctx)
 {
 	uint64_t ops = 0, bytes_rd = 0, bytes_wr = 0, checksum = 0;
+	uint64_t idx_cycles = 0, idx_ops = 0, lines = 0;
+	uint64_t perf[PERF_EVENT_COUNT] = { 0 };
+	unsigned perf_valid				= ctx->thread_count ? ~0u : 0;
 
 	for (int i = 0; i < ctx->thread_count; i++) {
 		ops += ctx->thread_stats[i].ops;
 		bytes_rd += ctx->thread_stats[i].bytes_rd;
 		bytes_wr += ctx->thread_stats[i].bytes_wr;
 		checksum ^= ctx->thread_stats[i].checksum;
+		idx_cycles += ctx->thread_stats[i].idx_cycles;
+		idx_ops += ctx->thread_stats[i].idx_ops;
+		lines += ctx->thread_stats[i].lines;
+		for (int e = 0; e < PERF_EVENT_COUNT; e++)
+			perf[e] += ctx->thread_stats[i].perf[e];
+		perf_valid &= ctx->thread_stats[i].perf_valid;
 	}
 
 	ctx->total_ops		= ops;
 	ctx->total_bytes_rd = bytes_rd;
 	ctx->total_bytes_wr = bytes_wr;
 	ctx->total_checksum = checksum;
+	ctx->total_idx_cycles = idx_cycles;
+	ctx->total_idx_ops	  = idx_ops;
+	ctx->total_lines	  = lines;
+	ctx->perf_valid		  = perf_valid;
+	memcpy(ctx->total_perf, perf, sizeof(perf));
+
+	hist_clear(ctx->lat_total);
+	for (int i = 0; i < ctx->thread_count; i++) {
+		hist_merge(ctx->lat_total, &ctx->thread_hists[i]);
+	}
+}
+
+// Append latency percentiles in ns, e.g. " p50_ns=81.2 ... max_ns=412.0"
+static void print_latency(const lat_hist_t *h, const char *sep)
+{
+	double ghz = tsc_ghz();
+
+	printf("%sp50_ns=%.1f%sp90_ns=%.1f%sp99_ns=%.1f%sp999_ns=%.1f%smax_ns=%.1f",
+		   sep, (double)hist_percentile(h, 0.50) / ghz, sep,
+		   (double)hist_percentile(h, 0.90) / ghz, sep,
+		   (double)hist_percentile(h, 0.99) / ghz, sep,
+		   (double)hist_percentile(h, 0.999) / ghz, sep,
+		   (double)h->max / ghz);
+}
+
+// Latency fields of a record; empty when nothing was sampled
+static void report_latency(const lat_hist_t *h)
+{
+	double ghz = tsc_ghz();
+	int	   has = h->count > 0;
+
+	report_u64("lat_samples", h->count);
+	report_f("p50_ns", has ? (double)hist_percentile(h, 0.50) / ghz : NAN, 1);
+	report_f("p90_ns", has ? (double)hist_percentile(h, 0.90) / ghz : NAN, 1);
+	report_f("p99_ns", has ? (double)hist_percentile(h, 0.99) / ghz : NAN, 1);
+	report_f("p999_ns", has ? (double)hist_percentile(h, 0.999) / ghz : NAN,
+			 1);
+	report_f("max_ns", has ? (double)h->max / ghz : NAN, 1);
 }
 
 void stats_stop(stats_ctx_t *ctx)
@@ -84,10 +196,27 @@ void stats_print_interval(stats_ctx_t *ctx, double interval_sec)
 
 	double elapsed = stats_elapsed(ctx);
 
-	printf("t=%.0fs bench=%s ops=%lu rd_GBs=%.2f wr_GBs=%.2f\n", elapsed,
-		   ctx->bench_name, delta_ops, rd_gbs, wr_gbs);
-	fflush(stdout);
+	hist_delta(ctx->lat_interval, ctx->lat_total, ctx->lat_last);
+	if (report_format() == FORMAT_TEXT) {
+		printf("t=%.0fs bench=%s ops=%lu rd_GBs=%.2f wr_GBs=%.2f", elapsed,
+			   ctx->bench_name, delta_ops, rd_gbs, wr_gbs);
+		if (ctx->lat_interval->count > 0) {
+			print_latency(ctx->lat_interval, " ");
+		}
+		printf("\n");
+		fflush(stdout);
+	} else {
+		report_begin("interval");
+		report_f("t", elapsed, 3);
+		report_str("bench", ctx->bench_name);
+		report_u64("ops", delta_ops);
+		report_f("rd_GBs", rd_gbs, 3);
+		report_f("wr_GBs", wr_gbs, 3);
+		report_latency(ctx->lat_interval);
+		report_end();
+	}
 
+	*ctx->lat_last	   = *ctx->lat_total;
 	ctx->last_ops	   = ctx->total_ops;
 	ctx->last_bytes_rd = ctx->total_bytes_rd;
 	ctx->last_bytes_wr = ctx->total_bytes_wr;
@@ -95,6 +224,9 @@ void stats_print_interval(stats_ctx_t *ctx, double interval_sec)
 
 void stats_print_final(stats_ctx_t *ctx)
 {
+	// Re-merge now that the reporter is gone; it may have raced stats_stop
+	stats_aggregate(ctx);
+
 	double rd_gbs = ctx->elapsed_sec > 0 ?
 						(double)ctx->total_bytes_rd / ctx->elapsed_sec / 1e9 :
 						0;
@@ -102,14 +234,109 @@ void stats_print_final(stats_ctx_t *ctx)
 						(double)ctx->total_bytes_wr / ctx->elapsed_sec / 1e9 :
 						0;
 
+	// Per-index cost of random index generation alone (rand_*)
+	double index_ns = ctx->total_idx_ops ?
+						  (double)ctx->total_idx_cycles /
+							  (double)ctx->total_idx_ops / tsc_ghz() :
+						  NAN;
+
+	// Bandwidth in whole lines touched, next to the useful bytes (stride_*)
+	double lines_gbs = ctx->total_lines && ctx->elapsed_sec > 0 ?
+						   (double)ctx->total_lines * CACHE_LINE_SIZE /
+							   ctx->elapsed_sec / 1e9 :
+						   NAN;
+
+	// Per-thread rate and time per op; min and max show how evenly the
+	// threads were served (contended atomics rarely are)
+	double thread_mops = 0, thread_min = 0, thread_max = 0;
+	if (ctx->elapsed_sec > 0 && ctx->thread_count > 0) {
+		for (int i = 0; i < ctx->thread_count; i++) {
+			double r = (double)ctx->thread_stats[i].ops / ctx->elapsed_sec / 1e6;
+			thread_mops += r;
+			if (i == 0 || r < thread_min)
+				thread_min = r;
+			if (r > thread_max)
+				thread_max = r;
+		}
+		thread_mops /= ctx->thread_count;
+	}
+	double thread_ns = thread_mops > 0 ? 1e3 / thread_mops : NAN;
+
+	// --perf counts per op; NaN where an event was not counted by every
+	// thread
+	double perf_per_op[PERF_EVENT_COUNT];
+	for (int e = 0; e < PERF_EVENT_COUNT; e++)
+		perf_per_op[e] = (ctx->perf_valid & (1u << e)) && ctx->total_ops ?
+							 (double)ctx->total_perf[e] /
+								 (double)ctx->total_ops :
+							 NAN;
+	double ipc = (ctx->perf_valid & (1u << PERF_CYCLES)) &&
+						 (ctx->perf_valid & (1u << PERF_INSTRUCTIONS)) &&
+						 ctx->total_perf[PERF_CYCLES] ?
+					 (double)ctx->total_perf[PERF_INSTRUCTIONS] /
+						 (double)ctx->total_perf[PERF_CYCLES] :
+					 NAN;
+
+	if (report_format() != FORMAT_TEXT) {
+		char checksum[32];
+		snprintf(checksum, sizeof(checksum), "0x%016lX", ctx->total_checksum);
+		report_begin("final");
+		report_str("bench", ctx->bench_name);
+		report_u64("total_ops", ctx->total_ops);
+		report_u64("total_bytes_rd", ctx->total_bytes_rd);
+		report_u64("total_bytes_wr", ctx->total_bytes_wr);
+		report_f("setup_sec", ctx->setup_sec, 3);
+		report_f("elapsed_sec", ctx->elapsed_sec, 3);
+		report_f("mean_rd_GBs", rd_gbs, 3);
+		report_f("mean_wr_GBs", wr_gbs, 3);
+		report_str("checksum", checksum);
+		report_f("index_ns", index_ns, 2);
+		report_f("lines_GBs", lines_gbs, 3);
+		report_f("thread_Mops", thread_mops, 3);
+		report_f("thread_Mops_min", thread_min, 3);
+		report_f("thread_Mops_max", thread_max, 3);
+		report_f("thread_ns_per_op", thread_ns, 2);
+		for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+			char key[48];
+			snprintf(key, sizeof(key), "%s_per_op",
+					 perf_event_name((perf_event_t)e));
+			report_f(key, perf_per_op[e], 4);
+		}
+		report_f("ipc", ipc, 3);
+		report_latency(ctx->lat_total);
+		report_end();
+		return;
+	}
+
 	printf("\n=== %s final ===\n", ctx->bench_name);
 	printf("total_ops=%lu\n", ctx->total_ops);
 	printf("total_bytes_rd=%lu\n", ctx->total_bytes_rd);
 	printf("total_bytes_wr=%lu\n", ctx->total_bytes_wr);
+	printf("setup_sec=%.2f\n", ctx->setup_sec);
 	printf("elapsed_sec=%.2f\n", ctx->elapsed_sec);
 	printf("mean_rd_GBs=%.2f\n", rd_gbs);
 	printf("mean_wr_GBs=%.2f\n", wr_gbs);
 	printf("checksum=0x%016lX\n", ctx->total_checksum);
+	if (ctx->total_idx_ops)
+		printf("index_ns=%.2f\n", index_ns);
+	if (ctx->total_lines)
+		printf("lines_GBs=%.2f\n", lines_gbs);
+	printf("thread_Mops=%.3f (min %.3f, max %.3f)\n", thread_mops, thread_min,
+		   thread_max);
+	if (!isnan(thread_ns))
+		printf("thread_ns_per_op=%.2f\n", thread_ns);
+	for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+		if (!isnan(perf_per_op[e]))
+			printf("%s_per_op=%.4f\n", perf_event_name((perf_event_t)e),
+				   perf_per_op[e]);
+	}
+	if (!isnan(ipc))
+		printf("ipc=%.3f\n", ipc);
+	if (ctx->lat_total->count > 0) {
+		printf("lat_samples=%lu", ctx->lat_total->count);
+		print_latency(ctx->lat_total, "\n");
+		printf("\n");
+	}
 	fflush(stdout);
 }
 
@@ -0,0 +1,1703 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "sweep.h"
+#include "runner.h"
+#include "bench.h"
+#include "tsc.h"
+#include "isa.h"
+#include "memory.h"
+#include "report.h"
+
+// Begin a <type> record for one sweep point with the fields every sweep
+// shares: the workload's bench, kernel ISA (empty if it has none), total
+// size and threads, and what it measured there (GB/s read + written,
+// per-thread ns per op, latency percentiles if sampled; empty if nothing
+// was). The caller adds the mode's own fields and ends the record.
+static void report_point(const char *type, const workload_ctx_t *wctx)
+{
+	const stats_ctx_t *st = &wctx->stats;
+	double			   gbs = NAN, ns = NAN, p50 = NAN, p99 = NAN;
+	if (st->total_ops && st->elapsed_sec > 0) {
+		gbs = (double)(st->total_bytes_rd + st->total_bytes_wr) /
+			  st->elapsed_sec / 1e9;
+		ns	= st->elapsed_sec * 1e9 * wctx->active / (double)st->total_ops;
+	}
+	if (st->lat_total->count) {
+		double ghz = tsc_ghz();
+		p50		   = (double)hist_percentile(st->lat_total, 0.50) / ghz;
+		p99		   = (double)hist_percentile(st->lat_total, 0.99) / ghz;
+	}
+
+	report_begin(type);
+	report_str("bench", wctx->bench->name);
+	report_str("isa", wctx->bench->func ? "" : isa_name(bench_isa()));
+	report_u64("size", (uint64_t)wctx->worker_ctxs[0].buffer_size *
+						   (uint64_t)wctx->active);
+	report_u64("threads", (uint64_t)wctx->active);
+	report_f("GBs", gbs, 3);
+	report_f("ns_per_op", ns, 2);
+	report_f("p50_ns", p50, 1);
+	report_f("p99_ns", p99, 1);
+}
+
+// Chain counts swept when --chains is not given
+static const int default_chains[] = { 1,  2,  3,  4,  5,  6,  7,  8,
+									  10, 12, 14, 16, 20, 24, 28, 32 };
+
+// Run ptr_chase_mlp once per chain count over one buffer and cycle, and
+// report per-thread throughput against K. By Little's law the achieved
+// memory-level parallelism is throughput(K) x latency(K=1), i.e. the
+// speedup over a single chain; it levels off at the number of misses a core
+// can keep outstanding (line-fill buffers).
+int run_mlp(cli_args_t *args)
+{
+	const bench_desc_t *bench = bench_lookup("ptr_chase_mlp");
+
+	const int *chains = args->chains;
+	int		   count  = args->chain_count;
+	if (count == 0) {
+		chains = default_chains;
+		count  = (int)(sizeof(default_chains) / sizeof(default_chains[0]));
+	}
+
+	topo_t topo;
+	if (runner_topo_init(args, &topo) < 0)
+		return -1;
+
+	printf("Running benchmark: %s sweep over %d chain counts\n", bench->name,
+		   count);
+	printf("Buffer size: %zu bytes, Threads: %d\n", args->buffer_size,
+		   args->threads);
+	if (args->stop_mode == STOP_TIME) {
+		printf("Stop mode: time (%.1f seconds per point)\n", args->seconds);
+	} else {
+		printf("Stop mode: iterations (%lu ops per point)\n", args->iters);
+	}
+	printf("\n");
+
+	workload_ctx_t wctx;
+	if (workload_init(&wctx, bench, args, &topo, NULL,
+					  cli_numa_spec(args, 0)) < 0) {
+		fprintf(stderr, "Failed to initialize workload\n");
+		topo_destroy(&topo);
+		return -1;
+	}
+	workload_print_placement(&wctx);
+
+	printf("%8s %12s %12s %10s\n", "chains", "Maccess/s", "ns/access",
+		   "mlp");
+
+	double base_ns	 = 0; // per-access latency of the first point
+	double peak_mlp	 = 0;
+	int	   peak_k	 = 0;
+	double setup_sec = 0;
+	for (int i = 0; i < count; i++) {
+		for (int t = 0; t < args->threads; t++) {
+			wctx.worker_ctxs[t].chains = chains[i];
+		}
+
+		workload_start(&wctx);
+		if (i == 0)
+			setup_sec = wctx.stats.setup_sec;
+
+		stats_ctx_t *st = &wctx.stats;
+		if (st->total_ops == 0 || st->elapsed_sec <= 0) {
+			fprintf(stderr, "No accesses measured at %d chains\n", chains[i]);
+			report_point("mlp", &wctx);
+			report_u64("chains", (uint64_t)chains[i]);
+			report_f("mlp", NAN, 2);
+			report_end();
+			continue;
+		}
+
+		// Per-thread rate; each thread walks its own chains
+		double rate = (double)st->total_ops / st->elapsed_sec /
+					  (double)args->threads;
+		double ns	= 1e9 / rate;
+		if (i == 0)
+			base_ns = ns * (double)chains[0];
+		double mlp = base_ns / ns;
+		if (mlp > peak_mlp) {
+			peak_mlp = mlp;
+			peak_k	 = chains[i];
+		}
+
+		printf("%8d %12.2f %12.2f %10.2f\n", chains[i], rate / 1e6, ns, mlp);
+		fflush(stdout);
+
+		report_point("mlp", &wctx);
+		report_u64("chains", (uint64_t)chains[i]);
+		report_f("mlp", mlp, 2);
+		report_end();
+	}
+
+	printf("\n=== %s summary ===\n", bench->name);
+	printf("latency_ns=%.2f\n", base_ns);
+	printf("peak_mlp=%.2f\n", peak_mlp);
+	printf("peak_chains=%d\n", peak_k);
+	printf("setup_sec=%.2f\n", setup_sec);
+
+	workload_destroy(&wctx);
+	topo_destroy(&topo);
+	return 0;
+}
+
+// Generator delays (cycles per line) swept when --delays is not given,
+// from light to full load
+static const int default_delays[] = { 10000, 5000, 2000, 1000, 500, 200,
+									  100,	 50,   20,	 0 };
+
+// Generators must honour worker_ctx_t.delay
+static int is_throttled(const bench_desc_t *bench)
+{
+	bench_func_t f = bench->isa_funcs[ISA_SCALAR];
+	return !bench->reuse_mode &&
+		   (f == bench_scalar_seq_read || f == bench_scalar_seq_write ||
+			f == bench_scalar_seq_rw);
+}
+
+// Loaded latency: one ptr_chase probe thread measures latency while
+// --threads generator threads stream through their own buffer with a delay
+// between lines. The first point runs the probe alone (idle latency), then
+// each delay adds load; the probe's run bounds each point and the generators
+// are stopped when it ends.
+int run_loaded_latency(cli_args_t *args)
+{
+	const bench_desc_t *probe_bench = bench_lookup("ptr_chase");
+	const bench_desc_t *gen_bench =
+		bench_lookup(args->bench_name[0] ? args->bench_name : "seq_read");
+	if (!gen_bench) {
+		fprintf(stderr, "Unknown benchmark: %s\n", args->bench_name);
+		return -1;
+	}
+	if (!is_throttled(gen_bench)) {
+		fprintf(stderr,
+				"%s cannot be throttled; use seq_read, seq_write or seq_rw\n",
+				gen_bench->name);
+		return -1;
+	}
+
+	const int *delays = args->delays;
+	int		   count  = args->delay_count;
+	if (count == 0) {
+		delays = default_delays;
+		count  = (int)(sizeof(default_delays) / sizeof(default_delays[0]));
+	}
+
+	topo_t topo;
+	if (runner_topo_init(args, &topo) < 0)
+		return -1;
+
+	// The probe is a one-thread copy of the run's settings
+	cli_args_t probe_args = *args;
+	probe_args.threads	  = 1;
+
+	printf("Running loaded latency: %s probe, %d x %s generators, %d load "
+		   "points\n",
+		   probe_bench->name, args->threads, gen_bench->name, count);
+	printf("Buffer size: %zu bytes each\n", args->buffer_size);
+	if (args->stop_mode == STOP_TIME) {
+		printf("Stop mode: time (%.1f seconds per point)\n", args->seconds);
+	} else {
+		printf("Stop mode: iterations (%lu probe ops per point)\n",
+			   args->iters);
+	}
+	printf("\n");
+
+	// Keep the probe off the generators' CPUs unless sharing was requested
+	unsigned char *cpu_used = NULL;
+	if (args->pin != PIN_NONE && !args->pin_share) {
+		cpu_used = calloc(MAX_CPUS, 1);
+		if (!cpu_used) {
+			topo_destroy(&topo);
+			return -1;
+		}
+	}
+
+	workload_ctx_t probe, gen;
+	if (workload_init(&probe, probe_bench, &probe_args, &topo, cpu_used,
+					  cli_numa_spec(args, 0)) < 0) {
+		fprintf(stderr, "Failed to initialize workload: %s\n",
+				probe_bench->name);
+		free(cpu_used);
+		topo_destroy(&topo);
+		return -1;
+	}
+	if (workload_init(&gen, gen_bench, args, &topo, cpu_used,
+					  cli_numa_spec(args, 1)) < 0) {
+		fprintf(stderr, "Failed to initialize workload: %s\n",
+				gen_bench->name);
+		workload_destroy(&probe);
+		free(cpu_used);
+		topo_destroy(&topo);
+		return -1;
+	}
+	workload_print_placement(&probe);
+	workload_print_placement(&gen);
+
+	// Fill both buffers up front so every point measures from its first op
+	workload_prepare(&probe);
+	workload_prepare(&gen);
+	printf("setup_sec=%.2f\n\n", probe.stats.setup_sec + gen.stats.setup_sec);
+
+	// Generators only stop when the probe is done
+	for (int t = 0; t < args->threads; t++) {
+		gen.worker_ctxs[t].stop_mode   = STOP_TIME;
+		gen.worker_ctxs[t].max_seconds = 1e9;
+		gen.worker_ctxs[t].max_iters   = UINT64_MAX;
+	}
+
+	printf("%8s %10s %10s %10s %10s\n", "delay", "gen_GBs", "lat_ns",
+		   "p50_ns", "p99_ns");
+
+	double ghz		= tsc_ghz();
+	double idle_ns	= 0;
+	double peak_bw	= 0;
+	double peak_ns	= 0;
+	for (int i = -1; i < count; i++) {
+		pthread_barrier_t	  global_barrier;
+		concurrent_workload_t cw = { &gen, &global_barrier, 0 };
+
+		// Point -1 is the probe alone
+		if (i >= 0) {
+			for (int t = 0; t < args->threads; t++) {
+				gen.worker_ctxs[t].delay = (uint32_t)delays[i];
+			}
+			pthread_barrier_init(&global_barrier, NULL, 2);
+			if (workload_launch(&cw) < 0) {
+				pthread_barrier_destroy(&global_barrier);
+				break;
+			}
+			pthread_barrier_wait(&global_barrier);
+		}
+
+		workload_start(&probe);
+
+		double gen_bw = 0;
+		if (i >= 0) {
+			workload_halt(&cw);
+			pthread_barrier_destroy(&global_barrier);
+			stats_ctx_t *gs = &gen.stats;
+			if (gs->elapsed_sec > 0)
+				gen_bw = (double)(gs->total_bytes_rd + gs->total_bytes_wr) /
+						 gs->elapsed_sec / 1e9;
+		}
+
+		// The probe's point, with the load the generators put beside it
+		report_point("loaded-latency", &probe);
+		report_f("delay", i < 0 ? NAN : (double)delays[i], 0);
+		report_str("gen_bench", gen_bench->name);
+		report_u64("gen_threads", (uint64_t)args->threads);
+		report_f("gen_GBs", gen_bw, 3);
+		report_end();
+
+		stats_ctx_t *ps = &probe.stats;
+		if (ps->total_ops == 0 || ps->elapsed_sec <= 0) {
+			fprintf(stderr, "No probe accesses measured\n");
+			continue;
+		}
+		double lat_ns = ps->elapsed_sec * 1e9 / (double)ps->total_ops;
+		double p50	  = (double)hist_percentile(ps->lat_total, 0.50) / ghz;
+		double p99	  = (double)hist_percentile(ps->lat_total, 0.99) / ghz;
+
+		if (i < 0) {
+			idle_ns = lat_ns;
+			printf("%8s %10.2f %10.1f %10.1f %10.1f\n", "idle", gen_bw, lat_ns,
+				   p50, p99);
+		} else {
+			printf("%8d %10.2f %10.1f %10.1f %10.1f\n", delays[i], gen_bw,
+				   lat_ns, p50, p99);
+		}
+		fflush(stdout);
+
+		if (gen_bw > peak_bw) {
+			peak_bw = gen_bw;
+			peak_ns = lat_ns;
+		}
+	}
+
+	printf("\n=== loaded latency summary ===\n");
+	printf("idle_latency_ns=%.1f\n", idle_ns);
+	printf("peak_gen_GBs=%.2f\n", peak_bw);
+	printf("latency_at_peak_ns=%.1f\n", peak_ns);
+
+	workload_destroy(&gen);
+	workload_destroy(&probe);
+	free(cpu_used);
+	topo_destroy(&topo);
+	return 0;
+}
+
+// Print a byte count with a binary suffix, e.g. "48K" or "1.5M"
+static void format_bytes(size_t bytes, char *buf, size_t len)
+{
+	const char *suffix = "KMGT";
+	double		v	   = (double)bytes;
+	int			unit   = -1;
+
+	while (v >= 1024.0 && unit < 3) {
+		v /= 1024.0;
+		unit++;
+	}
+	if (unit < 0)
+		snprintf(buf, len, "%zu", bytes);
+	else
+		snprintf(buf, len, "%.3g%c", v, suffix[unit]);
+}
+
+// Geometric sizes from min to max, steps per doubling, each a whole number
+// of units (e.g. one line per thread); returns the count (caller frees *out)
+static int build_sizes(size_t min, size_t max, int steps, size_t unit,
+					   size_t **out)
+{
+	int	   cap	 = 2;
+	int	   count = 0;
+	for (size_t s = min; s < max; s *= 2)
+		cap += steps;
+
+	size_t *sizes = malloc((size_t)cap * sizeof(size_t));
+	if (!sizes)
+		return -1;
+
+	for (int k = 0; count < cap; k++) {
+		double s	= (double)min * pow(2.0, (double)k / steps);
+		size_t size = ((size_t)s + unit - 1) / unit * unit;
+		if (size >= max)
+			break;
+		if (count == 0 || size != sizes[count - 1])
+			sizes[count++] = size;
+	}
+	sizes[count++] = max / unit * unit;
+
+	*out = sizes;
+	return count;
+}
+
+// Drop in per-thread rate, relative to the previous size, that marks a knee
+#define KNEE_DROP 0.8
+
+// Working-set sweep: one buffer of the largest size, filled once. Each point
+// shrinks every worker's region to a prefix of its own chunk (the bench init
+// hook, e.g. the ptr_chase cycle, is rebuilt for it) and measures bandwidth
+// and per-op time. Rows are annotated where the footprint first exceeds a
+// cache level from sysfs and where the rate falls off a cliff.
+int run_size_sweep(cli_args_t *args)
+{
+	if (args->sweep_max)
+		args->buffer_size = args->sweep_max;
+	size_t min = args->sweep_min ? args->sweep_min : 4096;
+	if (min > args->buffer_size)
+		min = args->buffer_size;
+
+	size_t *sizes;
+	int		count = build_sizes(min, args->buffer_size, args->sweep_steps,
+								64 * (size_t)args->threads, &sizes);
+	if (count < 0)
+		return -1;
+
+	topo_t topo;
+	if (runner_topo_init(args, &topo) < 0) {
+		free(sizes);
+		return -1;
+	}
+
+	topo_cache_t caches[MAX_CACHES];
+	int			 ncaches = topo_caches(topo.count ? topo.cpus[0].cpu : 0,
+									   caches, MAX_CACHES);
+
+	// One bench via --bench, or each of --benches in turn
+	int nbench = args->bench_count ? args->bench_count : 1;
+	for (int b = 0; b < nbench; b++) {
+		const char *name = args->bench_count ? args->bench_list[b] :
+											   args->bench_name;
+		const bench_desc_t *bench = bench_lookup(name);
+		if (!bench) {
+			fprintf(stderr, "Unknown benchmark: %s\n", name);
+			continue;
+		}
+
+		char lo[32], hi[32];
+		format_bytes(sizes[0], lo, sizeof(lo));
+		format_bytes(sizes[count - 1], hi, sizeof(hi));
+		printf("Running benchmark: %s size sweep %s..%s (%d sizes)\n",
+			   bench->name, lo, hi, count);
+		printf("Threads: %d\n", args->threads);
+		if (args->stop_mode == STOP_TIME) {
+			printf("Stop mode: time (%.1f seconds per point)\n",
+				   args->seconds);
+		} else {
+			printf("Stop mode: iterations (%lu ops per point)\n", args->iters);
+		}
+		if (ncaches > 0) {
+			printf("Caches:");
+			for (int c = 0; c < ncaches; c++) {
+				char sz[32];
+				format_bytes(caches[c].size, sz, sizeof(sz));
+				printf(" L%d%s=%s", caches[c].level,
+					   caches[c].type == 'D' ? "d" : "", sz);
+				if (caches[c].shared > 1)
+					printf("/%dcpus", caches[c].shared);
+			}
+			printf("\n");
+		}
+		printf("\n");
+
+		workload_ctx_t wctx;
+		if (workload_init(&wctx, bench, args, &topo, NULL,
+						  cli_numa_spec(args, b)) < 0) {
+			fprintf(stderr, "Failed to initialize workload: %s\n",
+					bench->name);
+			continue;
+		}
+		workload_print_placement(&wctx);
+		workload_prepare(&wctx);
+		double setup_sec = wctx.stats.setup_sec;
+
+		printf("%10s %10s %10s %10s %10s  %s\n", "size", "per_thread",
+			   "GBs", "ns/op", "p50_ns", "note");
+
+		double		 ghz		= tsc_ghz();
+		double		 prev_rate	= 0;
+		unsigned int exceeded	= 0; // caches already outgrown
+		char		 knees[256] = "";
+		size_t		 knees_len	= 0;
+		for (int i = 0; i < count; i++) {
+			workload_resize(&wctx, sizes[i]);
+			workload_start(&wctx);
+			setup_sec += wctx.stats.setup_sec;
+
+			size_t		 per_thread = wctx.worker_ctxs[0].buffer_size;
+			stats_ctx_t *st			= &wctx.stats;
+			char		 sz[32], pt[32];
+			format_bytes(sizes[i], sz, sizeof(sz));
+			format_bytes(per_thread, pt, sizeof(pt));
+			if (st->total_ops == 0 || st->elapsed_sec <= 0) {
+				printf("%10s %10s %10s\n", sz, pt, "-");
+				report_point("size-sweep", &wctx);
+				report_str("note", "");
+				report_end();
+				continue;
+			}
+
+			double gbs = (double)(st->total_bytes_rd + st->total_bytes_wr) /
+						 st->elapsed_sec / 1e9;
+			double rate = (double)st->total_ops / st->elapsed_sec /
+						  (double)args->threads;
+			char p50[32] = "-";
+			if (st->lat_total->count)
+				snprintf(p50, sizeof(p50), "%.1f",
+						 (double)hist_percentile(st->lat_total, 0.50) / ghz);
+
+			// A cache is outgrown once the threads that can share one
+			// instance together touch more than it holds (in every array
+			// of a multi-array bench)
+			char note[128] = "";
+			size_t nlen	   = 0;
+			for (int c = 0; c < ncaches && c < 32; c++) {
+				int	   sharers = caches[c].shared < args->threads ?
+									 caches[c].shared :
+									 args->threads;
+				size_t load	   = per_thread * (size_t)wctx.narrays *
+							  (size_t)sharers;
+				if ((exceeded & (1u << c)) || load <= caches[c].size)
+					continue;
+				exceeded |= 1u << c;
+				nlen += (size_t)snprintf(note + nlen, sizeof(note) - nlen,
+										 "%s>L%d%s", nlen ? " " : "",
+										 caches[c].level,
+										 caches[c].type == 'D' ? "d" : "");
+			}
+			if (prev_rate > 0 && rate < prev_rate * KNEE_DROP &&
+				nlen < sizeof(note)) {
+				nlen += (size_t)snprintf(note + nlen, sizeof(note) - nlen,
+										 "%sknee", nlen ? " " : "");
+				if (knees_len < sizeof(knees))
+					knees_len += (size_t)snprintf(
+						knees + knees_len, sizeof(knees) - knees_len, "%s%s",
+						knees_len ? "," : "", sz);
+			}
+			prev_rate = rate;
+
+			printf("%10s %10s %10.2f %10.2f %10s  %s\n", sz, pt, gbs,
+				   1e9 / rate, p50, note);
+			fflush(stdout);
+
+			report_point("size-sweep", &wctx);
+			report_str("note", note);
+			report_end();
+		}
+
+		printf("\n=== %s size sweep summary ===\n", bench->name);
+		printf("knees=%s\n", knees_len ? knees : "none");
+		printf("setup_sec=%.2f\n\n", setup_sec);
+
+		workload_destroy(&wctx);
+	}
+
+	free(sizes);
+	topo_destroy(&topo);
+	return 0;
+}
+
+// Share of peak aggregate bandwidth that counts as saturated
+#define SATURATION 0.95
+
+// Thread scaling: one buffer filled by the largest thread count, then each
+// point runs the first t workers with the buffer split evenly between them.
+// Efficiency is per-thread bandwidth relative to the first point; the knee
+// is the smallest count that reaches SATURATION of the peak aggregate.
+int run_scaling(cli_args_t *args)
+{
+	const bench_desc_t *bench = bench_lookup(args->bench_name);
+	if (!bench) {
+		fprintf(stderr, "Unknown benchmark: %s\n", args->bench_name);
+		return -1;
+	}
+
+	int counts[MAX_THREAD_STEPS];
+	int count = args->thread_list_count;
+	if (count > 0) {
+		memcpy(counts, args->thread_list, (size_t)count * sizeof(int));
+		args->threads = 0;
+		for (int i = 0; i < count; i++) {
+			if (counts[i] > args->threads)
+				args->threads = counts[i];
+		}
+	} else {
+		count = args->threads < MAX_THREAD_STEPS ? args->threads :
+												   MAX_THREAD_STEPS;
+		for (int i = 0; i < count; i++)
+			counts[i] = i + 1;
+	}
+	if (args->threads > MAX_THREADS) {
+		fprintf(stderr, "At most %d threads\n", MAX_THREADS);
+		return -1;
+	}
+
+	topo_t topo;
+	if (runner_topo_init(args, &topo) < 0)
+		return -1;
+
+	printf("Running benchmark: %s thread scaling over %d counts (max %d)\n",
+		   bench->name, count, args->threads);
+	printf("Buffer size: %zu bytes shared\n", args->buffer_size);
+	if (args->stop_mode == STOP_TIME) {
+		printf("Stop mode: time (%.1f seconds per point)\n", args->seconds);
+	} else {
+		printf("Stop mode: iterations (%lu ops per point)\n", args->iters);
+	}
+	printf("\n");
+
+	workload_ctx_t wctx;
+	if (workload_init(&wctx, bench, args, &topo, NULL,
+					  cli_numa_spec(args, 0)) < 0) {
+		fprintf(stderr, "Failed to initialize workload\n");
+		topo_destroy(&topo);
+		return -1;
+	}
+	workload_print_placement(&wctx);
+	workload_prepare(&wctx);
+	double setup_sec = wctx.stats.setup_sec;
+
+	double *agg = calloc((size_t)count, sizeof(double));
+	if (!agg) {
+		workload_destroy(&wctx);
+		topo_destroy(&topo);
+		return -1;
+	}
+
+	printf("%8s %12s %12s %10s %10s\n", "threads", "GBs", "GBs/thread",
+		   "eff", "gain");
+
+	double base = 0; // per-thread GB/s at the first point
+	double peak = 0;
+	for (int i = 0; i < count; i++) {
+		int t = counts[i];
+		workload_set_threads(&wctx, t);
+		workload_start(&wctx);
+		setup_sec += wctx.stats.setup_sec;
+
+		stats_ctx_t *st = &wctx.stats;
+		if (st->elapsed_sec > 0)
+			agg[i] = (double)(st->total_bytes_rd + st->total_bytes_wr) /
+					 st->elapsed_sec / 1e9;
+		double per = agg[i] / t;
+		if (i == 0)
+			base = per;
+		if (agg[i] > peak)
+			peak = agg[i];
+
+		double eff	= base > 0 ? per / base : 0;
+		double gain = i > 0 && agg[i - 1] > 0 ? agg[i] / agg[i - 1] : 1.0;
+		printf("%8d %12.2f %12.2f %9.0f%% %10.2f\n", t, agg[i], per,
+			   100.0 * eff, gain);
+		fflush(stdout);
+
+		report_point("scaling", &wctx);
+		report_f("GBs_per_thread", per, 3);
+		report_f("eff", eff, 3);
+		report_f("gain", gain, 3);
+		report_end();
+	}
+
+	// Knee: fewest threads already within SATURATION of the peak
+	int knee = 0;
+	for (int i = 0; i < count; i++) {
+		if (agg[i] >= SATURATION * peak && (knee == 0 || counts[i] < knee))
+			knee = counts[i];
+	}
+
+	printf("\n=== %s scaling summary ===\n", bench->name);
+	printf("peak_GBs=%.2f\n", peak);
+	printf("knee_threads=%d\n", knee);
+	printf("setup_sec=%.2f\n", setup_sec);
+
+	free(agg);
+	workload_destroy(&wctx);
+	topo_destroy(&topo);
+	return 0;
+}
+
+// Accumulator counts swept when --unroll is not given
+static const int default_unrolls[] = { 1, 2, 4, 8 };
+
+// Benchmarks the width sweep runs when neither --bench nor --benches is set
+static const char *const default_width_benches[] = { "seq_read", "seq_write",
+													  "seq_rw" };
+
+#define MAX_WIDTH_POINTS (MAX_CACHES + 1)
+
+// One point per cache level: half its capacity for each thread group that
+// shares an instance, so the working set fits with room to spare. A last
+// point at --size, raised to 8x the last level, stands for memory.
+static int width_points(const cli_args_t *args, const topo_cache_t *caches,
+						int ncaches, size_t *sizes, char labels[][16])
+{
+	size_t unit	 = 64 * (size_t)args->threads;
+	size_t mem	 = args->buffer_size;
+	int	   count = 0;
+
+	for (int c = 0; c < ncaches && count < MAX_WIDTH_POINTS - 1; c++) {
+		int sharers = caches[c].shared < args->threads ? caches[c].shared :
+														 args->threads;
+		if (sharers < 1)
+			sharers = 1;
+		size_t per_thread = caches[c].size / 2 / (size_t)sharers;
+		size_t total	  = per_thread * (size_t)args->threads / unit * unit;
+		if (total < unit)
+			continue;
+		snprintf(labels[count], 16, "L%d%s", caches[c].level,
+				 caches[c].type == 'D' ? "d" : "");
+		sizes[count++] = total;
+		if (mem < 8 * total)
+			mem = 8 * total;
+	}
+	snprintf(labels[count], 16, "mem");
+	sizes[count++] = mem / unit * unit;
+	return count;
+}
+
+// Width x unroll matrix: each seq_* benchmark runs once per supported kernel
+// ISA and accumulator count at one working-set size per cache level and one
+// in memory. Rows show GB/s per unroll and the core clock right after the
+// best run, so a lower clock for wider vectors (the AVX-512 frequency
+// license) shows up next to what it costs in bandwidth; vs_ymm compares each
+// row's best with the avx2 row of the same level.
+int run_width(cli_args_t *args)
+{
+	const int *unrolls = args->unroll;
+	int		   nunroll = args->unroll_count;
+	if (nunroll == 0) {
+		unrolls = default_unrolls;
+		nunroll = (int)(sizeof(default_unrolls) / sizeof(default_unrolls[0]));
+	}
+
+	topo_t topo;
+	if (runner_topo_init(args, &topo) < 0)
+		return -1;
+
+	topo_cache_t caches[MAX_CACHES];
+	int			 ncaches = topo_caches(topo.count ? topo.cpus[0].cpu : 0,
+									   caches, MAX_CACHES);
+
+	// --sizes replaces the per-level points
+	size_t	sizes[MAX_WIDTH_POINTS];
+	char	labels[MAX_WIDTH_POINTS][16];
+	size_t *range  = NULL;
+	int		npoint = 0;
+	if (args->sweep_max) {
+		size_t min = args->sweep_min ? args->sweep_min : 4096;
+		npoint	   = build_sizes(min, args->sweep_max, args->sweep_steps,
+								 64 * (size_t)args->threads, &range);
+		if (npoint < 0) {
+			topo_destroy(&topo);
+			return -1;
+		}
+	} else {
+		npoint = width_points(args, caches, ncaches, sizes, labels);
+		range  = sizes;
+	}
+	args->buffer_size = range[npoint - 1];
+
+	// Up to two summary lines per point, printed after each table
+	char (*summary)[128] = malloc((size_t)npoint * 2 * sizeof(*summary));
+	if (!summary) {
+		if (range != sizes)
+			free(range);
+		topo_destroy(&topo);
+		return -1;
+	}
+
+	isa_t saved = bench_isa();
+	isa_t best	= isa_detect();
+	int	  nbench =
+		  args->bench_count ? args->bench_count :
+		  args->bench_name[0] ?
+							  1 :
+							  (int)(sizeof(default_width_benches) /
+									sizeof(default_width_benches[0]));
+
+	tsc_ghz(); // calibrate before the workers probe the clock
+
+	for (int b = 0; b < nbench; b++) {
+		const char *name = args->bench_count ? args->bench_list[b] :
+						   args->bench_name[0] ? args->bench_name :
+												 default_width_benches[b];
+		const bench_desc_t *bench = bench_lookup(name);
+		if (!bench || !bench->isa_funcs[ISA_SCALAR]) {
+			fprintf(stderr, "%s has no per-ISA kernels\n", name);
+			continue;
+		}
+
+		printf("Running benchmark: %s width sweep, isa scalar..%s, unroll",
+			   bench->name, isa_name(best));
+		for (int u = 0; u < nunroll; u++)
+			printf("%c%d", u ? ',' : ' ', unrolls[u]);
+		printf("\nThreads: %d\n", args->threads);
+		if (args->stop_mode == STOP_TIME) {
+			printf("Stop mode: time (%.1f seconds per point)\n",
+				   args->seconds);
+		} else {
+			printf("Stop mode: iterations (%lu ops per point)\n", args->iters);
+		}
+		printf("\n");
+
+		workload_ctx_t wctx;
+		if (workload_init(&wctx, bench, args, &topo, NULL,
+						  cli_numa_spec(args, b)) < 0) {
+			fprintf(stderr, "Failed to initialize workload: %s\n",
+					bench->name);
+			continue;
+		}
+		workload_print_placement(&wctx);
+		workload_prepare(&wctx);
+		wctx.probe_clock = 1;
+
+		printf("%6s %8s %7s", "level", "size", "isa");
+		for (int u = 0; u < nunroll; u++) {
+			char col[16];
+			snprintf(col, sizeof(col), "x%d_GBs", unrolls[u]);
+			printf(" %9s", col);
+		}
+		printf(" %9s %7s %7s\n", "best_GBs", "GHz", "vs_ymm");
+
+		int nsummary = 0;
+		for (int p = 0; p < npoint; p++) {
+			char label[32];
+			if (range == sizes)
+				snprintf(label, sizeof(label), "%s", labels[p]);
+			else
+				format_bytes(range[p], label, sizeof(label));
+			workload_resize(&wctx, range[p]);
+
+			double gbs[ISA_COUNT][MAX_UNROLL];
+			double top[ISA_COUNT] = { 0 };
+			double ghz[ISA_COUNT] = { 0 };
+			int	   top_u[ISA_COUNT] = { 0 };
+			for (int isa = ISA_SCALAR; isa <= best; isa++) {
+				bench_set_isa((isa_t)isa);
+				for (int u = 0; u < nunroll; u++) {
+					for (int t = 0; t < wctx.active; t++)
+						wctx.worker_ctxs[t].unroll = unrolls[u];
+					workload_start(&wctx);
+
+					double run_ghz = 0;
+					for (int t = 0; t < wctx.active; t++)
+						run_ghz += wctx.worker_ctxs[t].core_ghz;
+					run_ghz /= wctx.active;
+					report_point("width", &wctx);
+					report_str("level", label);
+					report_u64("unroll", (uint64_t)unrolls[u]);
+					report_f("GHz", run_ghz, 2);
+					report_end();
+
+					stats_ctx_t *st = &wctx.stats;
+					gbs[isa][u]		= st->elapsed_sec > 0 ?
+										  (double)(st->total_bytes_rd +
+												   st->total_bytes_wr) /
+											  st->elapsed_sec / 1e9 :
+										  0;
+					if (gbs[isa][u] <= top[isa])
+						continue;
+					top[isa]   = gbs[isa][u];
+					top_u[isa] = unrolls[u];
+					ghz[isa]   = run_ghz;
+				}
+			}
+
+			char sz[32];
+			format_bytes(wctx.worker_ctxs[0].buffer_size *
+							 (size_t)wctx.active,
+						 sz, sizeof(sz));
+			int winner = ISA_SCALAR;
+			for (int isa = ISA_SCALAR; isa <= best; isa++) {
+				printf("%6s %8s %7s", label, sz, isa_name((isa_t)isa));
+				for (int u = 0; u < nunroll; u++)
+					printf(" %9.2f", gbs[isa][u]);
+				printf(" %9.2f %7.2f", top[isa], ghz[isa]);
+				if (best >= ISA_AVX2 && top[ISA_AVX2] > 0)
+					printf(" %7.2f\n", top[isa] / top[ISA_AVX2]);
+				else
+					printf(" %7s\n", "-");
+				if (top[isa] > top[winner])
+					winner = isa;
+			}
+			fflush(stdout);
+
+			snprintf(summary[nsummary++], sizeof(summary[0]),
+					 "%s_best=%sx%d %.2f GB/s", label,
+					 isa_name((isa_t)winner), top_u[winner], top[winner]);
+			if (best >= ISA_AVX512 && top[ISA_AVX2] > 0 && ghz[ISA_AVX2] > 0)
+				snprintf(summary[nsummary++], sizeof(summary[0]),
+						 "%s_zmm_vs_ymm=%.2f GBs, %.2f clock", label,
+						 top[ISA_AVX512] / top[ISA_AVX2],
+						 ghz[ISA_AVX512] / ghz[ISA_AVX2]);
+		}
+
+		printf("\n=== %s width summary ===\n", bench->name);
+		for (int i = 0; i < nsummary; i++)
+			printf("%s\n", summary[i]);
+		printf("\n");
+
+		workload_destroy(&wctx);
+	}
+
+	bench_set_isa(saved);
+	free(summary);
+	if (range != sizes)
+		free(range);
+	topo_destroy(&topo);
+	return 0;
+}
+
+// Smallest page count per thread the TLB sweep starts from
+#define TLB_MIN_PAGES 8
+
+// TLB reach: tlb_chase over a growing number of 4 KB pages per thread, once
+// on 4 KB pages and once on huge pages (--pages, THP by default). Both walk
+// the same lines in the same order, so their cycles per access differ only
+// in address translation: walk_cyc is that difference, the page-walk cost
+// of each access the 4 KB TLB entries no longer cover. Knees mark page
+// counts where one backing's cycles per access jump.
+int run_tlb(cli_args_t *args)
+{
+	const bench_desc_t *bench = bench_lookup("tlb_chase");
+	size_t				unit  = 4096 * (size_t)args->threads;
+
+	size_t max = args->sweep_max ? args->sweep_max : args->buffer_size;
+	size_t min = args->sweep_min ? args->sweep_min : TLB_MIN_PAGES * unit;
+	if (min < unit)
+		min = unit;
+	if (max < min)
+		max = min;
+	size_t *sizes;
+	int		count = build_sizes(min, max, args->sweep_steps, unit, &sizes);
+	if (count < 0)
+		return -1;
+	args->buffer_size = sizes[count - 1];
+
+	topo_t topo;
+	if (runner_topo_init(args, &topo) < 0) {
+		free(sizes);
+		return -1;
+	}
+
+	printf("Running benchmark: %s TLB sweep %zu..%zu pages per thread "
+		   "(%d points)\n",
+		   bench->name, sizes[0] / unit, sizes[count - 1] / unit, count);
+	printf("Threads: %d\n", args->threads);
+	if (args->stop_mode == STOP_TIME) {
+		printf("Stop mode: time (%.1f seconds per point)\n", args->seconds);
+	} else {
+		printf("Stop mode: iterations (%lu ops per point)\n", args->iters);
+	}
+	printf("\n");
+
+	// 4 KB first, then the huge backing; each gets its own buffer
+	page_mode_t	   requested = args->pages;
+	page_mode_t	   backing[2] = { PAGES_4K,
+								  requested == PAGES_4K ? PAGES_THP : requested };
+	workload_ctx_t wctx[2];
+	double		   setup_sec = 0;
+	for (int b = 0; b < 2; b++) {
+		args->pages = backing[b];
+		int ret		= workload_init(&wctx[b], bench, args, &topo, NULL,
+									cli_numa_spec(args, 0));
+		args->pages = requested;
+		if (ret < 0) {
+			fprintf(stderr, "Failed to initialize %s workload\n",
+					cli_page_mode_name(backing[b]));
+			if (b)
+				workload_destroy(&wctx[0]);
+			free(sizes);
+			topo_destroy(&topo);
+			return -1;
+		}
+		workload_prepare(&wctx[b]);
+		setup_sec += wctx[b].stats.setup_sec;
+
+		mem_page_info_t pinfo;
+		if (mem_page_info(wctx[b].buffer, wctx[b].buffer_size, &pinfo) == 0)
+			printf("%s backing: %s, %.1f of %.1f MB on huge pages\n",
+				   b ? "huge" : "base", cli_page_mode_name(wctx[b].pages),
+				   (double)pinfo.huge_bytes / (1024.0 * 1024.0),
+				   (double)pinfo.rss_bytes / (1024.0 * 1024.0));
+	}
+	workload_print_placement(&wctx[0]);
+
+	// Core clock for cycles per access, probed once: the chase runs no
+	// vector code, so no frequency license changes between runs. An
+	// interrupted probe reads low, so keep the highest of a few.
+	double ghz = 0;
+	for (int i = 0; i < 5; i++) {
+		double g = tsc_core_ghz();
+		if (g > ghz)
+			ghz = g;
+	}
+	printf("Core clock: %.2f GHz\n\n", ghz);
+
+	printf("%8s %8s %9s %9s %9s %9s %9s  %s\n", "pages", "span", "4k_ns",
+		   "4k_cyc", "huge_ns", "huge_cyc", "walk_cyc", "note");
+
+	double prev_cyc[2]	 = { 0, 0 };
+	char   knees[2][256] = { "", "" };
+	size_t knees_len[2]	 = { 0, 0 };
+	double max_walk		 = 0;
+	size_t max_walk_at	 = 0;
+	for (int i = 0; i < count; i++) {
+		size_t pages = sizes[i] / unit;
+		double ns[2] = { 0, 0 }, cyc[2] = { 0, 0 };
+		for (int b = 0; b < 2; b++) {
+			workload_resize(&wctx[b], sizes[i]);
+			workload_start(&wctx[b]);
+			setup_sec += wctx[b].stats.setup_sec;
+
+			stats_ctx_t *st = &wctx[b].stats;
+			if (st->total_ops > 0 && st->elapsed_sec > 0) {
+				// Per-thread time per access; each thread chases its own
+				// pages
+				ns[b]  = st->elapsed_sec * 1e9 * (double)args->threads /
+						 (double)st->total_ops;
+				cyc[b] = ns[b] * ghz;
+			}
+
+			// One record per backing; walk_cyc is 4k's cyc minus huge's
+			report_point("tlb", &wctx[b]);
+			report_u64("pages", (uint64_t)pages);
+			report_str("backing", cli_page_mode_name(wctx[b].pages));
+			report_f("cyc", ns[b] > 0 ? cyc[b] : NAN, 1);
+			report_end();
+		}
+
+		char span[32];
+		format_bytes(pages * 4096, span, sizeof(span));
+		if (ns[0] == 0 || ns[1] == 0) {
+			printf("%8zu %8s %9s\n", pages, span, "-");
+			continue;
+		}
+
+		char   note[64] = "";
+		size_t nlen		= 0;
+		for (int b = 0; b < 2; b++) {
+			if (prev_cyc[b] > 0 && cyc[b] * KNEE_DROP > prev_cyc[b]) {
+				nlen += (size_t)snprintf(note + nlen, sizeof(note) - nlen,
+										 "%s%s-knee", nlen ? " " : "",
+										 b ? "huge" : "4k");
+				if (knees_len[b] < sizeof(knees[b]))
+					knees_len[b] += (size_t)snprintf(
+						knees[b] + knees_len[b],
+						sizeof(knees[b]) - knees_len[b], "%s%zu",
+						knees_len[b] ? "," : "", pages);
+			}
+			prev_cyc[b] = cyc[b];
+		}
+
+		double walk = cyc[0] - cyc[1];
+		if (walk > max_walk) {
+			max_walk	= walk;
+			max_walk_at = pages;
+		}
+
+		printf("%8zu %8s %9.2f %9.1f %9.2f %9.1f %9.1f  %s\n", pages, span,
+			   ns[0], cyc[0], ns[1], cyc[1], walk, note);
+		fflush(stdout);
+	}
+
+	printf("\n=== %s TLB sweep summary ===\n", bench->name);
+	printf("huge_backing=%s\n", cli_page_mode_name(wctx[1].pages));
+	printf("4k_knees=%s\n", knees_len[0] ? knees[0] : "none");
+	printf("huge_knees=%s\n", knees_len[1] ? knees[1] : "none");
+	printf("max_walk_cyc=%.1f at %zu pages\n", max_walk, max_walk_at);
+	printf("setup_sec=%.2f\n\n", setup_sec);
+
+	workload_destroy(&wctx[1]);
+	workload_destroy(&wctx[0]);
+	free(sizes);
+	topo_destroy(&topo);
+	return 0;
+}
+
+// Distances swept when --prefetch-dist is not given: lines ahead for the
+// random kernels, hops ahead for ptr_chase_pf
+static const int default_pf_dists[]	   = { 8, 16, 32, 64, 128, 256 };
+static const int default_chase_dists[] = { 2, 4, 8, 16 };
+
+static const char *default_pf_benches[] = { "rand_read_pf", "rand_rw_pf",
+											"ptr_chase_pf" };
+
+// Ops per second over all threads, 0 if nothing was measured
+static double op_rate(const stats_ctx_t *st)
+{
+	if (st->total_ops == 0 || st->elapsed_sec <= 0)
+		return 0;
+	return (double)st->total_ops / st->elapsed_sec;
+}
+
+// Software prefetch: each *_pf kernel at every hint x distance, against its
+// plain kernel (the name without _pf) on a buffer of the same size. The
+// speedup column is what explicit prefetching buys an access pattern whose
+// addresses are known that far ahead.
+int run_prefetch(cli_args_t *args)
+{
+	const prefetch_t all_hints[] = { PREFETCH_T0, PREFETCH_T2, PREFETCH_NTA,
+									 PREFETCH_W };
+	const prefetch_t *hints		 = args->prefetch;
+	int				  nhint		 = args->prefetch_count;
+	if (nhint == 0) {
+		hints = all_hints;
+		nhint = PREFETCH_COUNT;
+	}
+
+	int nbench = args->bench_count ? args->bench_count :
+				 args->bench_name[0] ?
+									 1 :
+									 (int)(sizeof(default_pf_benches) /
+										   sizeof(default_pf_benches[0]));
+
+	topo_t topo;
+	if (runner_topo_init(args, &topo) < 0)
+		return -1;
+
+	for (int b = 0; b < nbench; b++) {
+		const char *name = args->bench_count ? args->bench_list[b] :
+						   args->bench_name[0] ? args->bench_name :
+												 default_pf_benches[b];
+		const bench_desc_t *bench = bench_lookup(name);
+		size_t				len	  = strlen(name);
+		if (!bench || len < 4 || strcmp(name + len - 3, "_pf") != 0) {
+			fprintf(stderr, "%s is not a prefetch kernel\n", name);
+			continue;
+		}
+		char base_name[64];
+		snprintf(base_name, sizeof(base_name), "%.*s", (int)(len - 3), name);
+		const bench_desc_t *base = bench_lookup(base_name);
+		if (!base) {
+			fprintf(stderr, "%s has no plain kernel %s\n", name, base_name);
+			continue;
+		}
+
+		const int *dists = args->prefetch_dist;
+		int		   ndist = args->prefetch_dist_count;
+		if (ndist == 0 && bench->init) {
+			dists = default_chase_dists;
+			ndist = (int)(sizeof(default_chase_dists) /
+						  sizeof(default_chase_dists[0]));
+		} else if (ndist == 0) {
+			dists = default_pf_dists;
+			ndist = (int)(sizeof(default_pf_dists) /
+						  sizeof(default_pf_dists[0]));
+		}
+
+		printf("Running benchmark: %s prefetch sweep, %d hints x %d "
+			   "distances vs %s\n",
+			   bench->name, nhint, ndist, base->name);
+		printf("Buffer size: %zu bytes, Threads: %d\n", args->buffer_size,
+			   args->threads);
+		if (args->stop_mode == STOP_TIME) {
+			printf("Stop mode: time (%.1f seconds per point)\n",
+				   args->seconds);
+		} else {
+			printf("Stop mode: iterations (%lu ops per point)\n", args->iters);
+		}
+		printf("\n");
+
+		// The plain kernel first, in its own buffer, freed before the
+		// prefetch kernel's is allocated
+		workload_ctx_t wctx;
+		if (workload_init(&wctx, base, args, &topo, NULL,
+						  cli_numa_spec(args, b)) < 0) {
+			fprintf(stderr, "Failed to initialize workload: %s\n",
+					base->name);
+			continue;
+		}
+		workload_print_placement(&wctx);
+		workload_start(&wctx);
+		double base_rate = op_rate(&wctx.stats);
+		double setup_sec = wctx.stats.setup_sec;
+		report_point("prefetch", &wctx);
+		report_str("hint", "none");
+		report_f("dist", NAN, 0);
+		report_f("speedup", base_rate > 0 ? 1.0 : NAN, 2);
+		report_end();
+		workload_destroy(&wctx);
+		if (base_rate == 0) {
+			fprintf(stderr, "No accesses measured for %s\n", base->name);
+			continue;
+		}
+
+		if (workload_init(&wctx, bench, args, &topo, NULL,
+						  cli_numa_spec(args, b)) < 0) {
+			fprintf(stderr, "Failed to initialize workload: %s\n",
+					bench->name);
+			continue;
+		}
+
+		printf("%6s %6s %10s %10s %9s\n", "hint", "dist", "Mops/s",
+			   "ns/op", "speedup");
+		printf("%6s %6s %10.2f %10.2f %9.2f\n", "none", "-", base_rate / 1e6,
+			   1e9 * args->threads / base_rate, 1.0);
+
+		double best		 = 0;
+		int	   best_hint = 0, best_dist = 0;
+		for (int d = 0; d < ndist; d++) {
+			for (int t = 0; t < args->threads; t++)
+				wctx.worker_ctxs[t].prefetch_dist = (uint32_t)dists[d];
+			// The chase stores its hints in the nodes: rebuild them
+			if (bench->init)
+				workload_resize(&wctx, wctx.buffer_size);
+
+			for (int h = 0; h < nhint; h++) {
+				for (int t = 0; t < args->threads; t++)
+					wctx.worker_ctxs[t].prefetch = hints[h];
+				workload_start(&wctx);
+				setup_sec += wctx.stats.setup_sec;
+
+				double rate = op_rate(&wctx.stats);
+				report_point("prefetch", &wctx);
+				report_str("hint", cli_prefetch_name(hints[h]));
+				report_u64("dist", (uint64_t)dists[d]);
+				report_f("speedup", rate > 0 ? rate / base_rate : NAN, 2);
+				report_end();
+				if (rate == 0) {
+					printf("%6s %6d %10s\n", cli_prefetch_name(hints[h]),
+						   dists[d], "-");
+					continue;
+				}
+				double speedup = rate / base_rate;
+				if (speedup > best) {
+					best	  = speedup;
+					best_hint = h;
+					best_dist = dists[d];
+				}
+				printf("%6s %6d %10.2f %10.2f %9.2f\n",
+					   cli_prefetch_name(hints[h]), dists[d], rate / 1e6,
+					   1e9 * args->threads / rate, speedup);
+				fflush(stdout);
+			}
+		}
+
+		printf("\n=== %s prefetch summary ===\n", bench->name);
+		printf("plain_ns=%.2f\n", 1e9 * args->threads / base_rate);
+		printf("best=%s@%d %.2fx\n", cli_prefetch_name(hints[best_hint]),
+			   best_dist, best);
+		printf("setup_sec=%.2f\n\n", setup_sec);
+
+		workload_destroy(&wctx);
+	}
+
+	topo_destroy(&topo);
+	return 0;
+}
+
+// Strategies compared by the stores sweep, one table each
+static const char *const default_fill_benches[] = { "fill_store", "fill_nt",
+													"fill_stosb",
+													"fill_memset" };
+static const char *const default_copy_benches[] = { "copy_store", "copy_nt",
+													"copy_movsb",
+													"copy_memcpy" };
+
+#define MAX_STORE_BENCHES 8
+
+// Run one table of the stores sweep: every bench at every size (one
+// workload at a time, resized), then one row per size. Crossovers are
+// reported for each <prefix>_store / <prefix>_nt pair in the list.
+static void stores_table(cli_args_t *args, const topo_t *topo,
+						 const char *label, const char *const *names,
+						 int nbench, const size_t *sizes, int count)
+{
+	const bench_desc_t *benches[MAX_STORE_BENCHES];
+	double			   *gbs = calloc((size_t)nbench * (size_t)count,
+									 sizeof(double));
+	double				setup_sec = 0;
+	if (!gbs)
+		return;
+
+	for (int b = 0; b < nbench; b++) {
+		benches[b] = bench_lookup(names[b]);
+		if (!benches[b]) {
+			fprintf(stderr, "Unknown benchmark: %s\n", names[b]);
+			continue;
+		}
+
+		workload_ctx_t wctx;
+		if (workload_init(&wctx, benches[b], args, topo, NULL,
+						  cli_numa_spec(args, b)) < 0) {
+			fprintf(stderr, "Failed to initialize workload: %s\n", names[b]);
+			benches[b] = NULL;
+			continue;
+		}
+		if (b == 0)
+			workload_print_placement(&wctx);
+		workload_prepare(&wctx);
+		setup_sec += wctx.stats.setup_sec;
+
+		for (int i = 0; i < count; i++) {
+			workload_resize(&wctx, sizes[i]);
+			workload_start(&wctx);
+
+			stats_ctx_t *st = &wctx.stats;
+			if (st->elapsed_sec > 0)
+				gbs[b * count + i] = (double)(st->total_bytes_rd +
+											  st->total_bytes_wr) /
+									 st->elapsed_sec / 1e9;
+
+			report_point("stores", &wctx);
+			report_str("table", label);
+			report_end();
+		}
+		workload_destroy(&wctx);
+	}
+
+	printf("%10s", "size");
+	for (int b = 0; b < nbench; b++)
+		printf(" %12s", names[b]);
+	printf("  %s\n", "best");
+	for (int i = 0; i < count; i++) {
+		char sz[32];
+		format_bytes(sizes[i], sz, sizeof(sz));
+		printf("%10s", sz);
+		int best = -1;
+		for (int b = 0; b < nbench; b++) {
+			double g = gbs[b * count + i];
+			if (!benches[b] || g == 0) {
+				printf(" %12s", "-");
+				continue;
+			}
+			printf(" %12.2f", g);
+			if (best < 0 || g > gbs[best * count + i])
+				best = b;
+		}
+		printf("  %s\n", best >= 0 ? names[best] : "-");
+	}
+
+	printf("\n=== %s stores summary ===\n", label);
+	for (int s = 0; s < nbench; s++) {
+		size_t len = strlen(names[s]);
+		if (!benches[s] || len < 6 || strcmp(names[s] + len - 6, "_store"))
+			continue;
+		int nt = -1;
+		for (int b = 0; b < nbench; b++) {
+			if (benches[b] && strlen(names[b]) == len - 3 &&
+				strncmp(names[b], names[s], len - 6) == 0 &&
+				strcmp(names[b] + len - 6, "_nt") == 0)
+				nt = b;
+		}
+		if (nt < 0)
+			continue;
+
+		// Smallest size from which non-temporal stores win at every size
+		int from = count;
+		while (from > 0 && gbs[nt * count + from - 1] > gbs[s * count + from - 1])
+			from--;
+		char at[32] = "none";
+		if (from < count)
+			format_bytes(sizes[from], at, sizeof(at));
+		printf("%.*s_nt_crossover=%s\n", (int)(len - 6), names[s], at);
+	}
+	for (int b = 0; b < nbench; b++) {
+		if (benches[b])
+			printf("%s_at_max=%.2f GB/s\n", names[b],
+				   gbs[b * count + count - 1]);
+	}
+	printf("setup_sec=%.2f\n\n", setup_sec);
+	fflush(stdout);
+	free(gbs);
+}
+
+// Fill and copy strategies over buffer sizes: cached vector stores,
+// non-temporal stores, rep stosb / rep movsb and glibc memset / memcpy.
+// Cached stores win while the buffer fits in cache; past some size the
+// read-for-ownership they pay makes streaming stores faster, and the
+// crossover is where a large-buffer path should switch.
+int run_stores(cli_args_t *args)
+{
+	if (args->sweep_max)
+		args->buffer_size = args->sweep_max;
+	size_t min = args->sweep_min ? args->sweep_min : 4096;
+	if (min > args->buffer_size)
+		min = args->buffer_size;
+
+	size_t *sizes;
+	int		count = build_sizes(min, args->buffer_size, args->sweep_steps,
+								64 * (size_t)args->threads, &sizes);
+	if (count < 0)
+		return -1;
+
+	topo_t topo;
+	if (runner_topo_init(args, &topo) < 0) {
+		free(sizes);
+		return -1;
+	}
+
+	char lo[32], hi[32];
+	format_bytes(sizes[0], lo, sizeof(lo));
+	format_bytes(sizes[count - 1], hi, sizeof(hi));
+	printf("Running stores sweep %s..%s (%d sizes), GB/s read + written\n",
+		   lo, hi, count);
+	printf("Threads: %d\n", args->threads);
+	if (args->stop_mode == STOP_TIME) {
+		printf("Stop mode: time (%.1f seconds per point)\n", args->seconds);
+	} else {
+		printf("Stop mode: iterations (%lu ops per point)\n", args->iters);
+	}
+	printf("\n");
+
+	if (args->bench_count) {
+		const char *names[MAX_STORE_BENCHES];
+		int			n = args->bench_count < MAX_STORE_BENCHES ?
+							args->bench_count :
+							MAX_STORE_BENCHES;
+		for (int b = 0; b < n; b++)
+			names[b] = args->bench_list[b];
+		stores_table(args, &topo, "benches", names, n, sizes, count);
+	} else {
+		stores_table(args, &topo, "fill", default_fill_benches, 4, sizes,
+					 count);
+		stores_table(args, &topo, "copy", default_copy_benches, 4, sizes,
+					 count);
+	}
+
+	free(sizes);
+	topo_destroy(&topo);
+	return 0;
+}
+
+// Topology relation of two CPUs, from closest to farthest
+enum { C2C_SMT, C2C_LLC, C2C_PACKAGE, C2C_REMOTE, C2C_CLASSES };
+static const char *const c2c_class_names[C2C_CLASSES] = { "smt", "llc",
+														  "package",
+														  "remote" };
+
+// Only two distinct CPUs on one core are SMT siblings; run_c2c never pairs
+// a CPU with itself
+static int c2c_class(const topo_t *topo, int a, int b)
+{
+	const topo_cpu_t *x = topo_find(topo, a);
+	const topo_cpu_t *y = topo_find(topo, b);
+	if (!x || !y || x->package != y->package)
+		return C2C_REMOTE;
+	if (x->core == y->core && a != b)
+		return C2C_SMT;
+	return x->llc == y->llc ? C2C_LLC : C2C_PACKAGE;
+}
+
+// Core-to-core latency: c2c_pingpong with its two threads pinned to each
+// pair of CPUs (--cpus, or all) in turn, on a fresh line each time. A cell
+// is half the round trip: the time for one core to see a line the other
+// just wrote. Pairs are measured once and mirrored.
+int run_c2c(cli_args_t *args)
+{
+	const bench_desc_t *bench = bench_lookup("c2c_pingpong");
+
+	topo_t topo;
+	if (topo_discover(&topo) < 0) {
+		fprintf(stderr, "CPU topology unavailable, cannot pin\n");
+		return -1;
+	}
+	topo_print(&topo);
+
+	int cpus[MAX_CPUS];
+	int n = 0;
+	if (args->cpu_count) {
+		for (int i = 0; i < args->cpu_count; i++) {
+			for (int j = 0; j < n; j++) {
+				if (cpus[j] == args->cpu_list[i]) {
+					fprintf(stderr, "CPU %d listed twice in --cpus\n",
+							cpus[j]);
+					topo_destroy(&topo);
+					return -1;
+				}
+			}
+			cpus[n++] = args->cpu_list[i];
+		}
+	} else {
+		for (int i = 0; i < topo.count && n < MAX_CPUS; i++)
+			cpus[n++] = topo.cpus[i].cpu;
+	}
+	if (n < 2) {
+		fprintf(stderr, "c2c mode needs at least 2 CPUs (see --cpus)\n");
+		topo_destroy(&topo);
+		return -1;
+	}
+
+	double *ns = malloc((size_t)n * (size_t)n * sizeof(double));
+	if (!ns) {
+		topo_destroy(&topo);
+		return -1;
+	}
+	for (int i = 0; i < n * n; i++)
+		ns[i] = NAN;
+
+	// Each pair runs as its own two-thread workload on a small buffer
+	cli_args_t pair	 = *args;
+	pair.threads	 = 2;
+	pair.pin		 = PIN_LIST;
+	pair.cpu_count	 = 2;
+	pair.buffer_size = 2 * 4096;
+
+	printf("Running benchmark: %s over %d CPUs (%d pairs)\n", bench->name, n,
+		   n * (n - 1) / 2);
+	if (args->stop_mode == STOP_TIME) {
+		printf("Stop mode: time (%.2f seconds per pair)\n", args->seconds);
+	} else {
+		printf("Stop mode: iterations (%lu round trips per pair)\n",
+			   args->iters);
+		pair.iters = args->iters * 2;
+	}
+	printf("\n");
+
+	double setup_sec = 0;
+	for (int i = 0; i < n; i++) {
+		for (int j = i + 1; j < n; j++) {
+			pair.cpu_list[0] = cpus[i];
+			pair.cpu_list[1] = cpus[j];
+
+			workload_ctx_t wctx;
+			if (workload_init(&wctx, bench, &pair, &topo, NULL,
+							  cli_numa_spec(args, 0)) < 0) {
+				fprintf(stderr, "Failed to initialize pair %d,%d\n", cpus[i],
+						cpus[j]);
+				continue;
+			}
+			workload_start(&wctx);
+			setup_sec += wctx.stats.setup_sec;
+
+			// Both threads count the handoffs they receive
+			stats_ctx_t *st = &wctx.stats;
+			if (st->total_ops > 0 && st->elapsed_sec > 0)
+				ns[i * n + j] = ns[j * n + i] =
+					st->elapsed_sec * 1e9 / (double)st->total_ops;
+			workload_destroy(&wctx);
+		}
+	}
+
+	printf("%6s", "cpu");
+	for (int j = 0; j < n; j++)
+		printf(" %6d", cpus[j]);
+	printf("\n");
+	for (int i = 0; i < n; i++) {
+		printf("%6d", cpus[i]);
+		for (int j = 0; j < n; j++) {
+			if (isnan(ns[i * n + j]))
+				printf(" %6s", "-");
+			else
+				printf(" %6.1f", ns[i * n + j]);
+		}
+		printf("\n");
+
+		// One record per row: a CSV stream is the matrix itself
+		report_begin("c2c");
+		report_u64("cpu", (uint64_t)cpus[i]);
+		for (int j = 0; j < n; j++) {
+			char key[32];
+			snprintf(key, sizeof(key), "cpu%d", cpus[j]);
+			report_f(key, ns[i * n + j], 1);
+		}
+		report_end();
+	}
+
+	double sum[C2C_CLASSES] = { 0 };
+	int	   pairs[C2C_CLASSES] = { 0 };
+	int	   lo = -1, hi = -1;
+	for (int i = 0; i < n; i++) {
+		for (int j = i + 1; j < n; j++) {
+			double v = ns[i * n + j];
+			if (isnan(v))
+				continue;
+			int c = c2c_class(&topo, cpus[i], cpus[j]);
+			sum[c] += v;
+			pairs[c]++;
+			if (lo < 0 || v < ns[lo])
+				lo = i * n + j;
+			if (hi < 0 || v > ns[hi])
+				hi = i * n + j;
+		}
+	}
+
+	printf("\n=== %s summary ===\n", bench->name);
+	for (int c = 0; c < C2C_CLASSES; c++) {
+		if (pairs[c])
+			printf("%s_ns=%.1f (%d pairs)\n", c2c_class_names[c],
+				   sum[c] / pairs[c], pairs[c]);
+	}
+	if (lo >= 0) {
+		printf("min_ns=%.1f (%d,%d)\n", ns[lo], cpus[lo / n], cpus[lo % n]);
+		printf("max_ns=%.1f (%d,%d)\n", ns[hi], cpus[hi / n], cpus[hi % n]);
+	}
+	printf("setup_sec=%.2f\n\n", setup_sec);
+
+	free(ns);
+	topo_destroy(&topo);
+	return 0;
+}
+
+// Rings compared by the queue sweep, and the message sizes it walks
+static const char *const default_queue_benches[] = { "spsc_ring",
+													 "mpsc_ring" };
+static const size_t		 default_msg_sizes[]	 = { 8, 64, 256, 1024, 4096 };
+
+// Message rings over message sizes: each *_ring kernel at every --msg-size
+// on one workload, re-initialized per size. Mmsg/s and GB/s count the
+// messages consumers received, so GB/s is payload delivered; latency is
+// the TSC time from send to receive of sampled messages.
+int run_queue(cli_args_t *args)
+{
+	const size_t *msg	= args->msg_size;
+	int			  nmsg	= args->msg_size_count;
+	if (nmsg == 0) {
+		msg	 = default_msg_sizes;
+		nmsg = (int)(sizeof(default_msg_sizes) / sizeof(default_msg_sizes[0]));
+	}
+
+	int nbench = args->bench_count ? args->bench_count :
+				 args->bench_name[0] ?
+									 1 :
+									 (int)(sizeof(default_queue_benches) /
+										   sizeof(default_queue_benches[0]));
+
+	topo_t topo;
+	if (runner_topo_init(args, &topo) < 0)
+		return -1;
+
+	double ghz = tsc_ghz();
+	for (int b = 0; b < nbench; b++) {
+		const char *name = args->bench_count ? args->bench_list[b] :
+						   args->bench_name[0] ? args->bench_name :
+												 default_queue_benches[b];
+		const bench_desc_t *bench = bench_lookup(name);
+		if (!bench) {
+			fprintf(stderr, "Unknown benchmark: %s\n", name);
+			continue;
+		}
+
+		printf("Running benchmark: %s queue sweep, %d message sizes\n",
+			   bench->name, nmsg);
+		printf("Buffer size: %zu bytes, Threads: %d, Ring slots: %u\n",
+			   args->buffer_size, args->threads, args->ring_slots);
+		if (args->stop_mode == STOP_TIME) {
+			printf("Stop mode: time (%.1f seconds per point)\n",
+				   args->seconds);
+		} else {
+			printf("Stop mode: iterations (%lu messages per point)\n",
+				   args->iters);
+		}
+		printf("\n");
+
+		workload_ctx_t wctx;
+		if (workload_init(&wctx, bench, args, &topo, NULL,
+						  cli_numa_spec(args, b)) < 0) {
+			fprintf(stderr, "Failed to initialize workload: %s\n", name);
+			continue;
+		}
+		workload_print_placement(&wctx);
+		workload_prepare(&wctx);
+		double setup_sec = wctx.stats.setup_sec;
+
+		printf("%8s %10s %10s %10s %10s\n", "msg", "Mmsg/s", "GB/s",
+			   "p50_ns", "p99_ns");
+		double best		= 0;
+		int	   best_msg = -1;
+		for (int m = 0; m < nmsg; m++) {
+			for (int t = 0; t < args->threads; t++)
+				wctx.worker_ctxs[t].msg_size = (uint32_t)msg[m];
+			// The init hook lays out the ring for the new message size
+			workload_resize(&wctx, wctx.buffer_size);
+			workload_start(&wctx);
+			setup_sec += wctx.stats.setup_sec;
+
+			char sz[32];
+			format_bytes(msg[m], sz, sizeof(sz));
+			stats_ctx_t *st	  = &wctx.stats;
+			double		 rate = op_rate(st);
+			double		 gbs = NAN, p50 = NAN, p99 = NAN;
+			if (rate > 0) {
+				gbs = (double)st->total_bytes_rd / st->elapsed_sec / 1e9;
+				if (st->lat_total->count) {
+					p50 = (double)hist_percentile(st->lat_total, 0.50) / ghz;
+					p99 = (double)hist_percentile(st->lat_total, 0.99) / ghz;
+				}
+			}
+
+			report_begin("queue");
+			report_str("bench", bench->name);
+			report_u64("msg", msg[m]);
+			report_f("Mmsg_s", rate > 0 ? rate / 1e6 : NAN, 3);
+			report_f("GBs", gbs, 3);
+			report_f("p50_ns", p50, 1);
+			report_f("p99_ns", p99, 1);
+			report_end();
+
+			if (rate == 0) {
+				printf("%8s %10s\n", sz, "-");
+				continue;
+			}
+			if (gbs > best) {
+				best	 = gbs;
+				best_msg = m;
+			}
+			printf("%8s %10.2f %10.2f", sz, rate / 1e6, gbs);
+			if (!isnan(p50))
+				printf(" %10.1f %10.1f\n", p50, p99);
+			else
+				printf(" %10s %10s\n", "-", "-");
+			fflush(stdout);
+		}
+
+		printf("\n=== %s queue summary ===\n", bench->name);
+		if (best_msg >= 0) {
+			char sz[32];
+			format_bytes(msg[best_msg], sz, sizeof(sz));
+			printf("peak_GBs=%.2f (msg %s)\n", best, sz);
+		}
+		printf("setup_sec=%.2f\n\n", setup_sec);
+
+		workload_destroy(&wctx);
+	}
+
+	topo_destroy(&topo);
+	return 0;
+}
@@ -0,0 +1,487 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <dirent.h>
+#include <sched.h>
+#include "topology.h"
+
+#define SYSFS_CPU  "/sys/devices/system/cpu"
+#define SYSFS_NODE "/sys/devices/system/node"
+
+// Read first line of a sysfs file; returns 0 on success
+static int read_sysfs_line(const char *path, char *buf, size_t len)
+{
+	FILE *f = fopen(path, "r");
+	if (!f)
+		return -1;
+
+	if (!fgets(buf, (int)len, f)) {
+		fclose(f);
+		return -1;
+	}
+	fclose(f);
+
+	buf[strcspn(buf, "\n")] = '\0';
+	return 0;
+}
+
+static int read_sysfs_int(const char *path, int fallback)
+{
+	char buf[64];
+	if (read_sysfs_line(path, buf, sizeof(buf)) < 0)
+		return fallback;
+	return atoi(buf);
+}
+
+int topo_parse_cpulist(const char *str, int *out, int max)
+{
+	int			count = 0;
+	const char *p	  = str;
+
+	while (*p) {
+		while (*p == ' ' || *p == ',')
+			p++;
+		if (!*p)
+			break;
+		if (!isdigit((unsigned char)*p))
+			return -1;
+
+		char *end;
+		long  lo = strtol(p, &end, 10);
+		long  hi = lo;
+		if (*end == '-') {
+			hi = strtol(end + 1, &end, 10);
+		}
+		if (lo < 0 || hi < lo || hi >= MAX_CPUS)
+			return -1;
+
+		for (long c = lo; c <= hi; c++) {
+			if (count >= max)
+				return -1;
+			out[count++] = (int)c;
+		}
+		p = end;
+	}
+
+	return count;
+}
+
+// Lowest CPU id sharing the last-level cache with cpu
+static int discover_llc(int cpu)
+{
+	char path[256];
+	char buf[1024];
+	int	 best_level = -1;
+	int	 llc		= cpu;
+
+	for (int idx = 0;; idx++) {
+		snprintf(path, sizeof(path), SYSFS_CPU "/cpu%d/cache/index%d/level",
+				 cpu, idx);
+		int level = read_sysfs_int(path, -1);
+		if (level < 0)
+			break;
+		if (level <= best_level)
+			continue;
+
+		snprintf(path, sizeof(path),
+				 SYSFS_CPU "/cpu%d/cache/index%d/shared_cpu_list", cpu, idx);
+		if (read_sysfs_line(path, buf, sizeof(buf)) < 0)
+			continue;
+
+		// Lists are sorted, so the first number is the lowest CPU
+		int first;
+		if (sscanf(buf, "%d", &first) != 1)
+			continue;
+		best_level = level;
+		llc		   = first;
+	}
+
+	return llc;
+}
+
+// Position of cpu within its sorted SMT sibling list
+static int discover_smt_index(int cpu)
+{
+	char path[256];
+	char buf[1024];
+	int	 siblings[MAX_CPUS];
+
+	snprintf(path, sizeof(path),
+			 SYSFS_CPU "/cpu%d/topology/thread_siblings_list", cpu);
+	if (read_sysfs_line(path, buf, sizeof(buf)) < 0)
+		return 0;
+
+	int n = topo_parse_cpulist(buf, siblings, MAX_CPUS);
+	for (int i = 0; i < n; i++) {
+		if (siblings[i] == cpu)
+			return i;
+	}
+	return 0;
+}
+
+// Fill in NUMA node for every CPU from /sys/devices/system/node/nodeN/cpulist
+static int discover_nodes(topo_t *topo)
+{
+	topo->mem_nodes = 1;
+
+	DIR *dir = opendir(SYSFS_NODE);
+	if (!dir)
+		return 1;
+
+	int			   max_node = 0;
+	struct dirent *de;
+	char		   path[512];
+	char		  *buf	= malloc(8192);
+	int			  *cpus = malloc(MAX_CPUS * sizeof(int));
+	if (!buf || !cpus) {
+		free(buf);
+		free(cpus);
+		closedir(dir);
+		return 1;
+	}
+
+	while ((de = readdir(dir)) != NULL) {
+		if (strncmp(de->d_name, "node", 4) != 0 ||
+			!isdigit((unsigned char)de->d_name[4]))
+			continue;
+
+		int node = atoi(de->d_name + 4);
+		snprintf(path, sizeof(path), SYSFS_NODE "/%s/cpulist", de->d_name);
+		if (read_sysfs_line(path, buf, 8192) < 0)
+			continue;
+
+		int n = topo_parse_cpulist(buf, cpus, MAX_CPUS);
+		for (int i = 0; i < n; i++) {
+			for (int j = 0; j < topo->count; j++) {
+				if (topo->cpus[j].cpu == cpus[i])
+					topo->cpus[j].node = node;
+			}
+		}
+		if (node > max_node)
+			max_node = node;
+	}
+
+	// Memory-only or CPU-only nodes are common; prefer has_memory
+	if (read_sysfs_line(SYSFS_NODE "/has_memory", buf, 8192) == 0) {
+		int n = topo_parse_cpulist(buf, cpus, MAX_CPUS);
+		if (n > 0)
+			topo->mem_nodes = 0;
+		for (int i = 0; i < n; i++) {
+			if (cpus[i] < MAX_NUMA_NODES)
+				topo->mem_nodes |= 1ULL << cpus[i];
+			if (cpus[i] > max_node)
+				max_node = cpus[i];
+		}
+	}
+
+	free(buf);
+	free(cpus);
+	closedir(dir);
+	return max_node + 1;
+}
+
+int topo_discover(topo_t *topo)
+{
+	memset(topo, 0, sizeof(*topo));
+
+	cpu_set_t allowed;
+	CPU_ZERO(&allowed);
+	if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+		perror("sched_getaffinity");
+		return -1;
+	}
+
+	char buf[4096];
+	int *online = malloc(MAX_CPUS * sizeof(int));
+	if (!online)
+		return -1;
+
+	int n_online = 0;
+	if (read_sysfs_line(SYSFS_CPU "/online", buf, sizeof(buf)) == 0) {
+		n_online = topo_parse_cpulist(buf, online, MAX_CPUS);
+	}
+	if (n_online <= 0) {
+		// No sysfs: fall back to the affinity mask alone
+		n_online = 0;
+		for (int c = 0; c < MAX_CPUS && c < CPU_SETSIZE; c++) {
+			if (CPU_ISSET((size_t)c, &allowed))
+				online[n_online++] = c;
+		}
+	}
+
+	topo->cpus = calloc((size_t)n_online, sizeof(topo_cpu_t));
+	if (!topo->cpus) {
+		free(online);
+		return -1;
+	}
+
+	char path[256];
+	for (int i = 0; i < n_online; i++) {
+		int cpu = online[i];
+		if (cpu >= CPU_SETSIZE || !CPU_ISSET((size_t)cpu, &allowed))
+			continue;
+
+		topo_cpu_t *c = &topo->cpus[topo->count++];
+		c->cpu		  = cpu;
+
+		snprintf(path, sizeof(path),
+				 SYSFS_CPU "/cpu%d/topology/physical_package_id", cpu);
+		c->package = read_sysfs_int(path, 0);
+		if (c->package < 0)
+			c->package = 0;
+
+		snprintf(path, sizeof(path), SYSFS_CPU "/cpu%d/topology/core_id", cpu);
+		c->core = read_sysfs_int(path, cpu);
+
+		c->smt = discover_smt_index(cpu);
+		c->llc = discover_llc(cpu);
+	}
+	free(online);
+
+	if (topo->count == 0) {
+		fprintf(stderr, "No usable CPUs found\n");
+		topo_destroy(topo);
+		return -1;
+	}
+
+	topo->nodes = discover_nodes(topo);
+
+	// Count packages and rank cores within each package by core_id
+	for (int i = 0; i < topo->count; i++) {
+		topo_cpu_t *c	  = &topo->cpus[i];
+		int			first = 1;
+		for (int j = 0; j < i; j++) {
+			if (topo->cpus[j].package == c->package) {
+				first = 0;
+				break;
+			}
+		}
+		topo->packages += first;
+
+		if (c->smt != 0)
+			continue;
+		topo->cores++;
+		c->core_rank = 0;
+		for (int j = 0; j < topo->count; j++) {
+			const topo_cpu_t *o = &topo->cpus[j];
+			if (o->smt == 0 && o->package == c->package && o->core < c->core)
+				c->core_rank++;
+		}
+	}
+
+	// SMT siblings inherit the rank of their core
+	for (int i = 0; i < topo->count; i++) {
+		topo_cpu_t *c = &topo->cpus[i];
+		if (c->smt == 0)
+			continue;
+		for (int j = 0; j < topo->count; j++) {
+			const topo_cpu_t *o = &topo->cpus[j];
+			if (o->smt == 0 && o->package == c->package && o->core == c->core) {
+				c->core_rank = o->core_rank;
+				break;
+			}
+		}
+	}
+
+	return 0;
+}
+
+void topo_destroy(topo_t *topo)
+{
+	if (topo->cpus) {
+		free(topo->cpus);
+		topo->cpus = NULL;
+	}
+	topo->count = 0;
+}
+
+const topo_cpu_t *topo_find(const topo_t *topo, int cpu)
+{
+	for (int i = 0; i < topo->count; i++) {
+		if (topo->cpus[i].cpu == cpu)
+			return &topo->cpus[i];
+	}
+	return NULL;
+}
+
+void topo_print(const topo_t *topo)
+{
+	printf("Topology: %d CPUs, %d cores, %d packages, %d NUMA nodes\n",
+		   topo->count, topo->cores, topo->packages, topo->nodes);
+}
+
+int topo_caches(int cpu, topo_cache_t *out, int max)
+{
+	char path[256];
+	char buf[1024];
+	int	 count = 0;
+
+	for (int idx = 0; count < max; idx++) {
+		snprintf(path, sizeof(path), SYSFS_CPU "/cpu%d/cache/index%d/level",
+				 cpu, idx);
+		int level = read_sysfs_int(path, -1);
+		if (level < 0)
+			break;
+
+		snprintf(path, sizeof(path), SYSFS_CPU "/cpu%d/cache/index%d/type",
+				 cpu, idx);
+		if (read_sysfs_line(path, buf, sizeof(buf)) < 0 ||
+			strcmp(buf, "Instruction") == 0)
+			continue;
+		char type = buf[0] == 'D' ? 'D' : 'U';
+
+		// Sizes look like "48K" or "32M"
+		snprintf(path, sizeof(path), SYSFS_CPU "/cpu%d/cache/index%d/size",
+				 cpu, idx);
+		char  *end;
+		size_t size;
+		if (read_sysfs_line(path, buf, sizeof(buf)) < 0)
+			continue;
+		size = strtoul(buf, &end, 10);
+		if (*end == 'K')
+			size <<= 10;
+		else if (*end == 'M')
+			size <<= 20;
+		else if (*end == 'G')
+			size <<= 30;
+		if (size == 0)
+			continue;
+
+		int cpus[MAX_CPUS];
+		int shared = 1;
+		snprintf(path, sizeof(path),
+				 SYSFS_CPU "/cpu%d/cache/index%d/shared_cpu_list", cpu, idx);
+		if (read_sysfs_line(path, buf, sizeof(buf)) == 0) {
+			int n = topo_parse_cpulist(buf, cpus, MAX_CPUS);
+			if (n > 0)
+				shared = n;
+		}
+
+		out[count].level  = level;
+		out[count].type	  = type;
+		out[count].size	  = size;
+		out[count].shared = shared;
+		count++;
+	}
+
+	return count;
+}
+
+const char *topo_policy_name(pin_policy_t policy)
+{
+	switch (policy) {
+	case PIN_NONE:
+		return "none";
+	case PIN_COMPACT:
+		return "compact";
+	case PIN_SCATTER:
+		return "scatter";
+	case PIN_CORE:
+		return "core";
+	case PIN_LIST:
+		return "list";
+	}
+	return "unknown";
+}
+
+// Order CPUs by the sort keys of a policy (qsort_r comparator)
+static int cmp_placement(const void *a, const void *b, void *arg)
+{
+	const topo_cpu_t *x		 = *(const topo_cpu_t *const *)a;
+	const topo_cpu_t *y		 = *(const topo_cpu_t *const *)b;
+	pin_policy_t	  policy = *(const pin_policy_t *)arg;
+	int				  kx[3], ky[3];
+
+	if (policy == PIN_SCATTER) {
+		// Physical cores first, round-robin across packages
+		kx[0] = x->smt, kx[1] = x->core_rank, kx[2] = x->package;
+		ky[0] = y->smt, ky[1] = y->core_rank, ky[2] = y->package;
+	} else {
+		// Compact: fill a core's SMT siblings, then the next core
+		kx[0] = x->package, kx[1] = x->core_rank, kx[2] = x->smt;
+		ky[0] = y->package, ky[1] = y->core_rank, ky[2] = y->smt;
+	}
+
+	for (int i = 0; i < 3; i++) {
+		if (kx[i] != ky[i])
+			return kx[i] < ky[i] ? -1 : 1;
+	}
+	return x->cpu < y->cpu ? -1 : (x->cpu > y->cpu);
+}
+
+int topo_place(const topo_t *topo, pin_policy_t policy, const int *list,
+			   int list_count, int nthreads, unsigned char *used, int *out)
+{
+	if (policy == PIN_NONE) {
+		for (int i = 0; i < nthreads; i++)
+			out[i] = -1;
+		return 0;
+	}
+
+	// Build ordered candidate list
+	int *order = malloc((size_t)(topo->count + list_count) * sizeof(int));
+	if (!order)
+		return -1;
+	int norder = 0;
+
+	if (policy == PIN_LIST) {
+		for (int i = 0; i < list_count; i++) {
+			if (!topo_find(topo, list[i])) {
+				fprintf(stderr, "CPU %d is not online or not allowed\n",
+						list[i]);
+				free(order);
+				return -1;
+			}
+			order[norder++] = list[i];
+		}
+	} else {
+		const topo_cpu_t **sorted =
+			malloc((size_t)topo->count * sizeof(topo_cpu_t *));
+		if (!sorted) {
+			free(order);
+			return -1;
+		}
+		int nsorted = 0;
+		for (int i = 0; i < topo->count; i++) {
+			if (policy == PIN_CORE && topo->cpus[i].smt != 0)
+				continue;
+			sorted[nsorted++] = &topo->cpus[i];
+		}
+		qsort_r(sorted, (size_t)nsorted, sizeof(*sorted), cmp_placement,
+				&policy);
+		for (int i = 0; i < nsorted; i++)
+			order[norder++] = sorted[i]->cpu;
+		free(sorted);
+	}
+
+	if (norder == 0) {
+		free(order);
+		return -1;
+	}
+
+	// Take free CPUs in order; once exhausted, reuse the order cyclically
+	int assigned = 0;
+	for (int i = 0; i < norder && assigned < nthreads; i++) {
+		if (used && used[order[i]])
+			continue;
+		out[assigned++] = order[i];
+	}
+	if (assigned < nthreads) {
+		fprintf(stderr,
+				"Warning: %d threads but only %d free CPUs for %s pinning; "
+				"sharing CPUs\n",
+				nthreads, assigned, topo_policy_name(policy));
+		for (int i = 0; assigned < nthreads; i++)
+			out[assigned++] = order[i % norder];
+	}
+
+	if (used) {
+		for (int i = 0; i < nthreads; i++)
+			used[out[i]] = 1;
+	}
+
+	free(order);
+	return 0;
+}
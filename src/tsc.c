@@ -0,0 +1,68 @@
+#include <time.h>
+#include <pthread.h>
+#include "tsc.h"
+
+static pthread_once_t tsc_once = PTHREAD_ONCE_INIT;
+static double		  tsc_freq_ghz;
+
+static double now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void tsc_calibrate(void)
+{
+	struct timespec delay = { 0, 20 * 1000 * 1000 }; // 20 ms
+	double			best  = 0;
+
+	// Best of three to dodge preemption between the paired reads
+	for (int i = 0; i < 3; i++) {
+		double	 n0 = now_ns();
+		uint64_t t0 = tsc_start();
+		nanosleep(&delay, NULL);
+		double	 n1 = now_ns();
+		uint64_t t1 = tsc_start();
+
+		double ghz = (double)(t1 - t0) / (n1 - n0);
+		if (i == 0 || ghz < best)
+			best = ghz;
+	}
+
+	tsc_freq_ghz = best > 0 ? best : 1.0;
+}
+
+double tsc_ghz(void)
+{
+	pthread_once(&tsc_once, tsc_calibrate);
+	return tsc_freq_ghz;
+}
+
+// Adds per probe: long enough to swamp the fences, short enough to finish
+// before a frequency license expires
+#define CORE_PROBE_ADDS 50000
+
+double tsc_core_ghz(void)
+{
+	uint64_t x = 0, one = 1;
+
+	// Register operands: recent cores fold chains of add-immediate at rename
+	// and retire several per cycle
+	__asm__ volatile("" : "+r"(one));
+	uint64_t t0 = tsc_start();
+	for (int i = 0; i < CORE_PROBE_ADDS / 10; i++) {
+		// Ten adds on one register, each waiting for the last
+		__asm__ volatile("add %1, %0\n\tadd %1, %0\n\tadd %1, %0\n\t"
+						 "add %1, %0\n\tadd %1, %0\n\tadd %1, %0\n\t"
+						 "add %1, %0\n\tadd %1, %0\n\tadd %1, %0\n\t"
+						 "add %1, %0"
+						 : "+r"(x)
+						 : "r"(one));
+	}
+	uint64_t t1 = tsc_stop();
+
+	if (t1 <= t0)
+		return 0;
+	return (double)CORE_PROBE_ADDS * tsc_ghz() / (double)(t1 - t0);
+}